@@ -1,79 +1,485 @@
 #include <iostream>
+#include <fstream>
 #include <chrono>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
 #include <iomanip>
 #include <functional>
+#include <thread>
+#include <future>
+#include <atomic>
+#include <algorithm>
+#include <utility>
+#include <memory>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include "bbsgs/bbsgs.hpp"
+#include "bbsgs/bbsgs_c.h"
+#include "bbsgs/ec.hpp"
+
+/**
+ * @brief Latency distribution and throughput of one benchmark.
+ *
+ * Latencies are per operation, in nanoseconds. For very fast operations each
+ * sample times a short batch of calls and records the per-call mean, so the
+ * percentiles describe batches rather than single calls (see `batch`).
+ */
+struct BenchmarkResult {
+    std::string section;
+    std::string name;
+    size_t threads = 1;
+    bool pinned = false;
+    size_t items = 1;      // logical items per call, e.g. signatures in a batch
+    size_t batch = 1;      // calls per sample
+    size_t samples = 0;
+    double min_ns = 0, p50_ns = 0, p90_ns = 0, p99_ns = 0, max_ns = 0;
+    double mean_ns = 0, stddev_ns = 0;
+    double ops_per_sec = 0; // items per second, summed over all threads
+};
+
+/**
+ * @brief Pins the calling thread to one CPU. Returns false where unsupported.
+ */
+static bool pin_current_thread(size_t cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % CPU_SETSIZE, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+/**
+ * @brief Pins the calling thread to one CPU for the lifetime of the object and
+ * then restores its previous affinity, so threads spawned afterwards are not
+ * confined to that CPU.
+ */
+class ScopedPin {
+public:
+    explicit ScopedPin(size_t cpu) {
+#ifdef __linux__
+        saved_ok = pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved) == 0;
+        active = saved_ok && pin_current_thread(cpu);
+#else
+        (void)cpu;
+#endif
+    }
+
+    ~ScopedPin() {
+#ifdef __linux__
+        if (saved_ok) {
+            pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+        }
+#endif
+    }
+
+    ScopedPin(const ScopedPin&) = delete;
+    ScopedPin& operator=(const ScopedPin&) = delete;
+
+    bool active = false;
+
+private:
+#ifdef __linux__
+    cpu_set_t saved;
+#endif
+    bool saved_ok = false;
+};
 
 /**
- * @brief A simple class to run benchmarks and print formatted results.
+ * @brief Thread counts 1, 2, 4, ... up to and always including max_threads.
+ */
+static std::vector<size_t> thread_sweep(size_t max_threads) {
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(std::max<size_t>(max_threads, 1));
+    return counts;
+}
+
+/**
+ * @brief Runs benchmarks with auto-calibrated iteration counts and collects
+ * percentile statistics for text and JSON reporting.
+ *
+ * Each benchmark is first timed for a rough per-call cost. Calls cheaper than
+ * SAMPLE_FLOOR_NS are grouped into batches so timer overhead stays negligible,
+ * and the number of samples is chosen to fill `min_time_ms`, bounded by
+ * `min_samples` and `max_samples`.
  */
 class BenchmarkRunner {
 public:
-    int num_iters;
+    struct Options {
+        double min_time_ms = 500.0;
+        size_t min_samples = 5;
+        size_t max_samples = 20000;
+        bool pin = false;         // pin single-threaded runs to CPU 0
+        size_t max_threads = 0;   // upper bound of the thread sweep, 0 = all cores
+    };
+
+    explicit BenchmarkRunner(Options options) : opts(options) {
+        if (opts.max_threads == 0) {
+            opts.max_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    const Options& options() const { return opts; }
+    const std::vector<BenchmarkResult>& results() const { return all; }
+
+    void section(const std::string& title) {
+        current_section = title;
+        std::cout << "\n--- " << title << " ---" << std::endl;
+        std::cout << std::left << std::setw(32) << "" << "  "
+                  << std::right << std::setw(11) << "p50 ms" << std::setw(11) << "p90 ms"
+                  << std::setw(11) << "p99 ms" << std::setw(11) << "min ms" << std::setw(11) << "max ms"
+                  << std::setw(14) << "ops/s" << std::setw(9) << "samples" << std::endl;
+    }
+
+    /**
+     * @brief Benchmarks func on the calling thread. `items` is the number of
+     * logical operations one call performs and scales ops/s accordingly.
+     */
+    const BenchmarkResult& run(const std::string& name, const std::function<void()>& func, size_t items = 1) {
+        return run_on_caller(name, func, items, opts.pin);
+    }
+
+    /**
+     * @brief Like run(), but never pinned: for calls that spawn their own worker
+     * threads, which would otherwise inherit the caller's single-CPU affinity.
+     */
+    const BenchmarkResult& run_fanout(const std::string& name, const std::function<void()>& func, size_t items = 1) {
+        return run_on_caller(name, func, items, false);
+    }
+
+    /**
+     * @brief Benchmarks func on `threads` threads at once. func must be safe
+     * to call concurrently. All threads start together on a barrier; ops/s is
+     * the aggregate over the wall time of the whole run.
+     */
+    const BenchmarkResult& run_parallel(const std::string& name, size_t threads, bool pin,
+                                        const std::function<void()>& func, size_t items = 1) {
+        size_t batch, samples;
+        calibrate(func, batch, samples);
+
+        std::vector<std::vector<double>> per_thread(threads);
+        std::atomic<size_t> ready{0};
+        std::atomic<bool> go{false};
+        std::atomic<bool> pin_ok{true};
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                if (pin && !pin_current_thread(t)) pin_ok = false;
+                per_thread[t].reserve(samples);
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (size_t s = 0; s < samples; ++s) {
+                    auto t0 = Clock::now();
+                    for (size_t i = 0; i < batch; ++i) func();
+                    per_thread[t].push_back(elapsed_ns(t0, Clock::now()) / batch);
+                }
+            });
+        }
+        while (ready.load() < threads) std::this_thread::yield();
+        auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& w : workers) w.join();
+        double wall_ns = elapsed_ns(start, Clock::now());
+
+        std::vector<double> latencies;
+        latencies.reserve(threads * samples);
+        for (const auto& v : per_thread) latencies.insert(latencies.end(), v.begin(), v.end());
+
+        BenchmarkResult r = summarize(name, latencies, batch, items);
+        r.threads = threads;
+        r.pinned = pin && pin_ok;
+        r.ops_per_sec = (double)(threads * samples * batch * items) / (wall_ns / 1e9);
+        return record(std::move(r));
+    }
+
+    void write_json(std::ostream& out) const {
+        out << "{\n"
+            << "  \"library\": \"bbsgs\",\n"
+            << "  \"curve\": \"" << ecgroup::Curve::NAME << "\",\n"
+            << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n"
+            << "  \"min_time_ms\": " << opts.min_time_ms << ",\n"
+            << "  \"results\": [";
+        for (size_t i = 0; i < all.size(); ++i) {
+            const BenchmarkResult& r = all[i];
+            out << (i ? ",\n" : "\n") << std::setprecision(10)
+                << "    {\"section\": \"" << json_escape(r.section) << "\""
+                << ", \"name\": \"" << json_escape(r.name) << "\""
+                << ", \"threads\": " << r.threads
+                << ", \"pinned\": " << (r.pinned ? "true" : "false")
+                << ", \"items\": " << r.items
+                << ", \"batch\": " << r.batch
+                << ", \"samples\": " << r.samples
+                << ", \"min_ns\": " << r.min_ns
+                << ", \"p50_ns\": " << r.p50_ns
+                << ", \"p90_ns\": " << r.p90_ns
+                << ", \"p99_ns\": " << r.p99_ns
+                << ", \"max_ns\": " << r.max_ns
+                << ", \"mean_ns\": " << r.mean_ns
+                << ", \"stddev_ns\": " << r.stddev_ns
+                << ", \"ops_per_sec\": " << r.ops_per_sec << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Calls cheaper than this are batched so timer overhead stays below ~1%.
+    static constexpr double SAMPLE_FLOOR_NS = 20000.0;
+
+    const BenchmarkResult& run_on_caller(const std::string& name, const std::function<void()>& func,
+                                         size_t items, bool pin_caller) {
+        // Pinned only for this run; later sweeps and pools must see every CPU
+        std::unique_ptr<ScopedPin> pin;
+        if (pin_caller) {
+            pin.reset(new ScopedPin(0));
+        }
+        size_t batch, samples;
+        calibrate(func, batch, samples);
+
+        std::vector<double> latencies;
+        latencies.reserve(samples);
+        auto start = Clock::now();
+        for (size_t s = 0; s < samples; ++s) {
+            auto t0 = Clock::now();
+            for (size_t i = 0; i < batch; ++i) func();
+            latencies.push_back(elapsed_ns(t0, Clock::now()) / batch);
+        }
+        double wall_ns = elapsed_ns(start, Clock::now());
+
+        BenchmarkResult r = summarize(name, latencies, batch, items);
+        r.pinned = pin && pin->active;
+        r.ops_per_sec = (double)(samples * batch * items) / (wall_ns / 1e9);
+        return record(std::move(r));
+    }
+
+    Options opts;
+    std::string current_section;
+    std::vector<BenchmarkResult> all;
 
-    explicit BenchmarkRunner(int iterations) : num_iters(iterations) {}
+    static double elapsed_ns(Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double, std::nano>(to - from).count();
+    }
 
-    void run(const std::string& name, const std::function<void()>& func) {
-        // Run once to warm up caches, JIT, etc.
-        func(); 
+    void calibrate(const std::function<void()>& func, size_t& batch, size_t& samples) const {
+        // First call warms caches and lazily built tables; it is not measured.
+        func();
 
-        auto start = std::chrono::high_resolution_clock::now();
-        for (int i = 0; i < num_iters; ++i) {
-            func();
+        // Double the probe until it runs for a millisecond or so, which gives a
+        // stable per-call estimate even for sub-microsecond operations.
+        size_t probe = 1;
+        double per_call_ns;
+        for (;;) {
+            auto t0 = Clock::now();
+            for (size_t i = 0; i < probe; ++i) func();
+            double ns = elapsed_ns(t0, Clock::now());
+            if (ns >= 1e6 || probe >= (1u << 20)) {
+                per_call_ns = std::max(ns / probe, 1.0);
+                break;
+            }
+            probe *= 2;
         }
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double, std::milli> elapsed = end - start;
 
-        std::cout << std::left << std::setw(28) << name 
-                  << ": " << std::fixed << std::setprecision(6) 
-                  << elapsed.count() / num_iters << " ms" << std::endl;
+        batch = std::max<size_t>(1, (size_t)std::ceil(SAMPLE_FLOOR_NS / per_call_ns));
+        double budget_ns = opts.min_time_ms * 1e6;
+        samples = (size_t)(budget_ns / (per_call_ns * batch));
+        samples = std::min(std::max(samples, opts.min_samples), opts.max_samples);
+    }
+
+    // Nearest-rank percentile of a sorted sample.
+    static double percentile(const std::vector<double>& sorted, double p) {
+        size_t rank = (size_t)std::ceil(p * sorted.size());
+        return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+    }
+
+    BenchmarkResult summarize(const std::string& name, std::vector<double>& latencies, size_t batch, size_t items) const {
+        std::sort(latencies.begin(), latencies.end());
+        BenchmarkResult r;
+        r.section = current_section;
+        r.name = name;
+        r.items = items;
+        r.batch = batch;
+        r.samples = latencies.size();
+        r.min_ns = latencies.front();
+        r.p50_ns = percentile(latencies, 0.50);
+        r.p90_ns = percentile(latencies, 0.90);
+        r.p99_ns = percentile(latencies, 0.99);
+        r.max_ns = latencies.back();
+        double sum = 0, sq = 0;
+        for (double v : latencies) sum += v;
+        r.mean_ns = sum / latencies.size();
+        for (double v : latencies) sq += (v - r.mean_ns) * (v - r.mean_ns);
+        r.stddev_ns = latencies.size() > 1 ? std::sqrt(sq / (latencies.size() - 1)) : 0.0;
+        return r;
+    }
+
+    const BenchmarkResult& record(BenchmarkResult r) {
+        std::string label = r.name;
+        if (r.threads > 1 || r.pinned) {
+            label += " [" + std::to_string(r.threads) + "t" + (r.pinned ? ", pinned" : "") + "]";
+        }
+        std::cout << std::left << std::setw(32) << label << ": "
+                  << std::right << std::fixed << std::setprecision(4)
+                  << std::setw(11) << r.p50_ns / 1e6 << std::setw(11) << r.p90_ns / 1e6
+                  << std::setw(11) << r.p99_ns / 1e6 << std::setw(11) << r.min_ns / 1e6
+                  << std::setw(11) << r.max_ns / 1e6
+                  << std::setprecision(1) << std::setw(14) << r.ops_per_sec
+                  << std::setw(9) << r.samples << std::endl;
+        all.push_back(std::move(r));
+        return all.back();
+    }
+
+    static std::string json_escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
     }
 };
 
-int main() {
+static void print_usage(const char* argv0) {
+    std::cerr << "usage: " << argv0 << " [--json FILE] [--min-time MS] [--max-threads N] [--pin] [--seed N] [--max-keys N]\n"
+              << "  --json FILE      also write all results as JSON to FILE\n"
+              << "  --min-time MS    measurement budget per benchmark (default 500)\n"
+              << "  --max-threads N  upper bound of the thread sweep (default: all cores)\n"
+              << "  --pin            pin single-threaded runs to CPU 0\n"
+              << "  --seed N         deterministic randomness, for reproducible runs\n"
+              << "  --max-keys N     largest bulk key issuance to time (default 1000000)" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkRunner::Options options;
+    std::string json_path;
+    bool seeded = false;
+    uint64_t seed = 0;
+    size_t max_keys = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.min_time_ms = std::atof(argv[++i]);
+        } else if (arg == "--max-threads" && i + 1 < argc) {
+            options.max_threads = (size_t)std::atoi(argv[++i]);
+        } else if (arg == "--pin") {
+            options.pin = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seeded = true;
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--max-keys" && i + 1 < argc) {
+            max_keys = (size_t)std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
     ecgroup::init_pairing();
+    if (seeded) {
+        ecgroup::set_random_seed(seed);
+    }
+    std::cout << "Curve: " << ecgroup::Curve::NAME
+              << " (G1 " << ecgroup::G1_SERIALIZED_SIZE << " B, G2 " << ecgroup::G2_SERIALIZED_SIZE
+              << " B, signature " << bbsgs::GroupSignature::SERIALIZED_SIZE << " B)\n";
 
-    BenchmarkRunner primitive_runner(10000); // More iterations for fast ops
-    BenchmarkRunner protocol_runner(100);    // Fewer iterations for slow ops
+    BenchmarkRunner bench(options);
 
     // =====================================================================
     // SECTION 1: Low-Level Cryptographic Primitives
     // =====================================================================
-    std::cout << "--- Low-Level Cryptographic Primitives (Avg over " << primitive_runner.num_iters << " iters) ---" << std::endl;
+    bench.section("Low-Level Cryptographic Primitives");
 
     ecgroup::Scalar s1 = ecgroup::Scalar::get_random();
     ecgroup::Scalar s2 = ecgroup::Scalar::get_random();
-    primitive_runner.run("Scalar Multiplication", [&]() {
+    bench.run("Scalar Multiplication", [&]() {
         auto r = s1 * s2;
     });
 
+    bench.run("Random Scalar", [&]() {
+        auto r = ecgroup::Scalar::get_random();
+    });
+
+    ecgroup::Scalar nonces[7];
+    bench.run("Random Scalars (x7, one draw)", [&]() {
+        ecgroup::Scalar::fill_random(nonces, 7);
+    }, 7);
+
     ecgroup::G1Point p1 = ecgroup::G1Point::get_random();
-    primitive_runner.run("G1 Scalar Multiplication", [&]() {
+    bench.run("G1 Scalar Multiplication", [&]() {
         auto r = ecgroup::G1Point::mul(p1, s1);
     });
 
+    ecgroup::G1FixedBase p1_table(p1);
+    bench.run("G1 Fixed-Base Mul (w=4)", [&]() {
+        auto r = p1_table.mul(s1);
+    });
+
+    std::vector<ecgroup::G1Point> msm_points = {p1, ecgroup::G1Point::get_random(), ecgroup::G1Point::get_random()};
+    std::vector<ecgroup::Scalar> msm_scalars = {s1, s2, ecgroup::Scalar::get_random()};
+    bench.run("G1 Multi-Scalar Mul (3)", [&]() {
+        auto r = ecgroup::G1Point::multi_mul(msm_points, msm_scalars);
+    });
+
     ecgroup::G2Point p2 = ecgroup::G2Point::get_random();
-    primitive_runner.run("G2 Scalar Multiplication", [&]() {
+    bench.run("G2 Scalar Multiplication", [&]() {
         auto r = ecgroup::G2Point::mul(p2, s1);
     });
     
     ecgroup::PairingResult pr = ecgroup::pairing(p1, p2);
-    primitive_runner.run("Pairing Exponentiation", [&]() {
+    bench.run("Pairing Exponentiation", [&]() {
         auto r = pr.pow(s1);
     });
 
-    protocol_runner.run("Pairing", [&]() { // Pairing is slower, use fewer iters
+    ecgroup::GTFixedBase pr_table(pr);
+    bench.run("GT Fixed-Base Exp (w=4)", [&]() {
+        auto r = pr_table.pow(s1);
+    });
+
+    bench.run("Pairing", [&]() {
         auto r = ecgroup::pairing(p1, p2);
     });
 
+    ecgroup::PreparedG2Point p2_prepared(p2);
+    bench.run("Pairing (prepared G2)", [&]() {
+        auto r = ecgroup::pairing(p1, p2_prepared);
+    });
+
+    ecgroup::G1Point p1b = ecgroup::G1Point::get_random();
+    ecgroup::G2Point p2b = ecgroup::G2Point::get_random();
+    bench.run("Multi-Pairing (2 pairs)", [&]() {
+        auto r = ecgroup::multi_pairing({p1, p1b}, {p2, p2b});
+    });
+
+    ecgroup::PreparedG2Point p2b_prepared(p2b);
+    bench.run("Multi-Pairing (2, prepared)", [&]() {
+        auto r = ecgroup::multi_pairing(p1, p2_prepared, p1b, p2b_prepared);
+    });
+
+    ecgroup::Bytes large_message(4 * 1024 * 1024, 0xab);
+    bench.run("Challenge Hash (4 MB msg)", [&]() {
+        auto r = bbsgs::hash_all_to_scalar(large_message, p1, p1, p1, p1, p1, pr, p1, p1);
+    });
+
 
     // =====================================================================
     // SECTION 2: High-Level Protocol Operations
     // =====================================================================
-    std::cout << "\n--- High-Level Protocol Operations (Avg over " << protocol_runner.num_iters << " iters) ---" << std::endl;
+    bench.section("High-Level Protocol Operations");
 
     // --- One-time setup for all protocol benchmarks ---
     bbsgs::GroupPublicKey gpk;
@@ -85,28 +491,401 @@ int main() {
     bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk, usk, message);
     // --- End of setup ---
 
-    protocol_runner.run("Full Setup", [&]() {
+    bench.run("Full Setup", [&]() {
         bbsgs::GroupPublicKey gpk_b;
         bbsgs::OpenerSecretKey osk_b;
         bbsgs::IssuerSecretKey isk_b;
         bbsgs::bbs04_setup(gpk_b, osk_b, isk_b);
     });
 
-    protocol_runner.run("User Key Generation", [&]() {
+    bench.run("User Key Generation", [&]() {
         auto usk_b = bbsgs::bbs04_user_keygen(isk, gpk);
     });
 
-    protocol_runner.run("Sign", [&]() {
+    bench.run("Sign", [&]() {
         auto sigma_b = bbsgs::bbs04_sign(gpk, usk, message);
     });
     
-    protocol_runner.run("Verify", [&]() {
+    bench.run("Verify", [&]() {
         bbsgs::bbs04_verify(gpk, message, sigma);
     });
     
-    protocol_runner.run("Open", [&]() {
+    bench.run("Prepare Group Key (w=4)", [&]() {
+        bbsgs::PreparedGroupPublicKey pgpk_b(gpk);
+    });
+
+    bbsgs::PreparedGroupPublicKey pgpk(gpk);
+    std::cout << "  (prepared key tables: " << pgpk.table_size_bytes() / 1024 << " KB)" << std::endl;
+
+    bench.run("User Key Generation (prep)", [&]() {
+        auto usk_b = bbsgs::bbs04_user_keygen(isk, pgpk);
+    });
+
+    bench.run("Sign (prepared)", [&]() {
+        auto sigma_b = bbsgs::bbs04_sign(pgpk, usk, message);
+    });
+
+    bbsgs::PreparedUserSigningKey pusk(usk, gpk);
+    std::cout << "  (prepared signing key tables: " << pusk.table_size_bytes() / 1024 << " KB)" << std::endl;
+
+    bench.run("Sign (pairing-free)", [&]() {
+        auto sigma_b = bbsgs::bbs04_sign(pgpk, pusk, message);
+    });
+
+    {
+        bbsgs::PresignaturePool pool(gpk, usk, 128, 16, 2);
+        while (pool.stats().depth < 128) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        bench.run("Sign (online, pooled)", [&]() {
+            auto sigma_b = bbsgs::bbs04_sign_online(pool, message);
+        });
+        bbsgs::PresignaturePoolStats stats = pool.stats();
+        std::cout << "  (pool: consumed " << stats.consumed << ", misses " << stats.misses
+                  << ", refills " << stats.refills << ")" << std::endl;
+    }
+
+    bench.run("Verify (prepared)", [&]() {
+        bbsgs::bbs04_verify(pgpk, message, sigma);
+    });
+
+    bbsgs::GroupSignature sigma_v2 = bbsgs::bbs04_sign(pgpk, pusk, message, bbsgs::SignatureVersion::V2);
+    bench.run("Sign (pairing-free, v2)", [&]() {
+        auto sigma_b = bbsgs::bbs04_sign(pgpk, pusk, message, bbsgs::SignatureVersion::V2);
+    });
+
+    bench.run("Verify (prepared, v2)", [&]() {
+        bbsgs::bbs04_verify(pgpk, message, sigma_v2);
+    });
+
+    bench.run("Verify USK", [&]() {
+        bbsgs::bbs04_verify_usk(gpk, usk);
+    });
+
+    bench.run("Verify USK (prepared)", [&]() {
+        bbsgs::bbs04_verify_usk(pgpk, usk);
+    });
+
+    bench.run("Open", [&]() {
         auto opened_A = bbsgs::bbs04_open(gpk, osk, sigma);
     });
 
+
+    // =====================================================================
+    // SECTION 3: Serialization
+    // =====================================================================
+    bench.section("Serialization");
+
+    uint8_t scalar_buf[ecgroup::FR_SERIALIZED_SIZE];
+    s1.write_to(scalar_buf);
+    bench.run("Scalar Encode", [&]() {
+        s1.write_to(scalar_buf);
+    });
+    bench.run("Scalar Decode", [&]() {
+        auto decoded = ecgroup::Scalar::read_from(scalar_buf, sizeof(scalar_buf));
+    });
+
+    uint8_t g1_buf[ecgroup::G1_SERIALIZED_SIZE];
+    p1.write_to(g1_buf);
+    bench.run("G1 Encode", [&]() {
+        p1.write_to(g1_buf);
+    });
+    bench.run("G1 Decode", [&]() {
+        auto decoded = ecgroup::G1Point::read_from(g1_buf, sizeof(g1_buf));
+    });
+
+    uint8_t g2_buf[ecgroup::G2_SERIALIZED_SIZE];
+    p2.write_to(g2_buf);
+    bench.run("G2 Encode", [&]() {
+        p2.write_to(g2_buf);
+    });
+    bench.run("G2 Decode", [&]() {
+        auto decoded = ecgroup::G2Point::read_from(g2_buf, sizeof(g2_buf));
+    });
+
+    bench.run("GT Serialize (full)", [&]() {
+        uint8_t buf[ecgroup::GT_SERIALIZED_SIZE];
+        pr.write_to(buf);
+    });
+
+    bench.run("GT Serialize (compressed)", [&]() {
+        uint8_t buf[ecgroup::GT_COMPRESSED_SIZE];
+        pr.write_compressed_to(buf);
+    });
+
+    bench.run("Signature Encode", [&]() {
+        uint8_t buf[bbsgs::GroupSignature::SERIALIZED_SIZE];
+        sigma.write_to(buf);
+    });
+
+    ecgroup::Bytes sigma_compressed = sigma.to_bytes();
+    bench.run("Signature Decode (compressed)", [&]() {
+        auto decoded = bbsgs::GroupSignature::from_bytes(sigma_compressed);
+    });
+
+    ecgroup::Bytes sigma_uncompressed = sigma.to_bytes(ecgroup::PointEncoding::Uncompressed);
+    bench.run("Signature Decode (affine)", [&]() {
+        auto decoded = bbsgs::GroupSignature::from_bytes(sigma_uncompressed, ecgroup::PointEncoding::Uncompressed);
+    });
+
+    const std::pair<const char*, ecgroup::Validation> validation_modes[] = {
+        {"full", ecgroup::Validation::Full},
+        {"on-curve", ecgroup::Validation::OnCurve},
+        {"trusted", ecgroup::Validation::Trusted},
+    };
+    ecgroup::Bytes gpk_compressed = gpk.to_bytes();
+    for (const auto& mode : validation_modes) {
+        bench.run(std::string("Group Key Decode (") + mode.first + ")", [&]() {
+            auto decoded = bbsgs::GroupPublicKey::from_bytes(gpk_compressed, ecgroup::PointEncoding::Compressed, mode.second);
+        });
+    }
+    for (const auto& mode : validation_modes) {
+        bench.run(std::string("Sig Decode affine (") + mode.first + ")", [&]() {
+            auto decoded = bbsgs::GroupSignature::from_bytes(sigma_uncompressed, ecgroup::PointEncoding::Uncompressed, mode.second);
+        });
+    }
+
+
+    // =====================================================================
+    // SECTION 4: C API
+    // =====================================================================
+    bench.section("C API");
+
+    ecgroup::Bytes usk_bytes = usk.to_bytes();
+    ecgroup::Bytes osk_bytes = osk.to_bytes();
+
+    bench.run("bbs04_sign_c", [&]() {
+        unsigned char* sig = nullptr;
+        size_t sig_len = 0;
+        bbs04_sign_c(gpk_compressed.data(), gpk_compressed.size(),
+                     usk_bytes.data(), usk_bytes.size(),
+                     message.data(), message.size(), &sig, &sig_len);
+        free_byte_buffer(sig);
+    });
+
+    bench.run("bbs04_verify_c", [&]() {
+        bbs04_verify_c(gpk_compressed.data(), gpk_compressed.size(),
+                       sigma_compressed.data(), sigma_compressed.size(),
+                       message.data(), message.size());
+    });
+
+    unsigned char c_sig[BBS04_SIGNATURE_SIZE];
+    bench.run("bbs04_sign_into", [&]() {
+        bbs04_sign_into(gpk_compressed.data(), gpk_compressed.size(),
+                        usk_bytes.data(), usk_bytes.size(),
+                        message.data(), message.size(), c_sig, sizeof(c_sig));
+    });
+
+    bbs04_gpk_handle* gpk_h = bbs04_gpk_handle_new(gpk_compressed.data(), gpk_compressed.size());
+    bbs04_usk_handle* usk_h = bbs04_usk_handle_new(gpk_h, usk_bytes.data(), usk_bytes.size());
+    bbs04_osk_handle* osk_h = bbs04_osk_handle_new(osk_bytes.data(), osk_bytes.size());
+
+    bench.run("bbs04_sign_h_into", [&]() {
+        bbs04_sign_h_into(gpk_h, usk_h, message.data(), message.size(), c_sig, sizeof(c_sig));
+    });
+
+    bench.run("bbs04_verify_h", [&]() {
+        bbs04_verify_h(gpk_h, sigma_compressed.data(), sigma_compressed.size(),
+                       message.data(), message.size());
+    });
+
+    bench.run("bbs04_open_h_into", [&]() {
+        unsigned char cred[BBS04_CREDENTIAL_SIZE];
+        bbs04_open_h_into(gpk_h, osk_h, sigma_compressed.data(), sigma_compressed.size(),
+                          cred, sizeof(cred));
+    });
+
+    {
+        const size_t n = 64;
+        std::vector<unsigned char> packed_sigs;
+        std::vector<unsigned char> packed_msgs;
+        std::vector<size_t> sig_lens(n, sigma_compressed.size()), msg_lens(n, message.size());
+        for (size_t i = 0; i < n; ++i) {
+            packed_sigs.insert(packed_sigs.end(), sigma_compressed.begin(), sigma_compressed.end());
+            packed_msgs.insert(packed_msgs.end(), message.begin(), message.end());
+        }
+        std::vector<unsigned char> results(n);
+        bench.run("bbs04_verify_batch_h (n=64)", [&]() {
+            bbs04_verify_batch_h(gpk_h, n, packed_sigs.data(), sig_lens.data(),
+                                 packed_msgs.data(), msg_lens.data(), results.data());
+        }, n);
+    }
+
+
+    // =====================================================================
+    // SECTION 5: Multi-Core Scaling
+    // =====================================================================
+    bench.section("Multi-Core Scaling");
+
+    for (bool pin : {false, true}) {
+        for (size_t threads : thread_sweep(bench.options().max_threads)) {
+            bench.run_parallel("Sign (pairing-free)", threads, pin, [&]() {
+                auto sigma_b = bbsgs::bbs04_sign(pgpk, pusk, message);
+            });
+            bench.run_parallel("Verify (prepared)", threads, pin, [&]() {
+                bbsgs::bbs04_verify(pgpk, message, sigma);
+            });
+            bench.run_parallel("bbs04_verify_h", threads, pin, [&]() {
+                bbs04_verify_h(gpk_h, sigma_compressed.data(), sigma_compressed.size(),
+                               message.data(), message.size());
+            });
+        }
+    }
+
+    bbs04_osk_handle_free(osk_h);
+    bbs04_usk_handle_free(usk_h);
+    bbs04_gpk_handle_free(gpk_h);
+
+
+    // =====================================================================
+    // SECTION 6: Batch Verification Throughput
+    // =====================================================================
+    bench.section("Batch Verification Throughput");
+
+    const size_t max_batch = 4096;
+    std::vector<ecgroup::Bytes> batch_messages(max_batch, message);
+    std::vector<bbsgs::GroupSignature> batch_sigmas;
+    batch_sigmas.reserve(max_batch);
+    for (size_t i = 0; i < max_batch; ++i) {
+        batch_sigmas.push_back(bbsgs::bbs04_sign(gpk, usk, message));
+    }
+
+    for (size_t n = 1; n <= max_batch; n *= 4) {
+        std::vector<ecgroup::Bytes> msgs(batch_messages.begin(), batch_messages.begin() + n);
+        std::vector<bbsgs::GroupSignature> sigs(batch_sigmas.begin(), batch_sigmas.begin() + n);
+        bench.run("Verify Batch (n=" + std::to_string(n) + ")", [&]() {
+            bbsgs::bbs04_verify_batch(gpk, msgs, sigs);
+        }, n);
+        bench.run("Verify Batch (prepared, n=" + std::to_string(n) + ")", [&]() {
+            bbsgs::bbs04_verify_batch(pgpk, msgs, sigs);
+        }, n);
+        // Where this overtakes the unprepared row is the break-even batch size for
+        // building the tables per call
+        bench.run("Verify Batch (prepare per call, n=" + std::to_string(n) + ")", [&]() {
+            bbsgs::bbs04_verify_batch(bbsgs::PreparedGroupPublicKey(gpk), msgs, sigs);
+        }, n);
+    }
+
+
+    // =====================================================================
+    // SECTION 7: Batch Opening Throughput
+    // =====================================================================
+    bench.section("Batch Opening Throughput (n=" + std::to_string(max_batch) + ")");
+
+    bench.run("Open + Serialize (loop)", [&]() {
+        for (const auto& sig : batch_sigmas) {
+            auto opened_A = bbsgs::bbs04_open(gpk, osk, sig).to_bytes();
+        }
+    }, max_batch);
+
+    for (size_t threads : {size_t(1), size_t(0)}) {
+        std::string label = threads == 0 ? "all cores" : std::to_string(threads) + " thread";
+        bench.run_fanout("Open Batch (" + label + ")", [&]() {
+            auto opened = bbsgs::bbs04_open_batch(gpk, osk, batch_sigmas, threads);
+            for (const auto& A : opened) {
+                auto bytes = A.to_bytes();
+            }
+        }, max_batch);
+    }
+
+
+    // =====================================================================
+    // SECTION 8: Verify Engine Scaling
+    // =====================================================================
+    bench.section("Verify Engine Scaling (n=" + std::to_string(max_batch) + ")");
+
+    for (size_t threads : thread_sweep(bench.options().max_threads)) {
+        bbsgs::VerifyEngine engine(threads);
+        std::vector<std::future<bool>> pending;
+        pending.reserve(max_batch);
+        bench.run("Engine Verify (" + std::to_string(threads) + " threads)", [&]() {
+            pending.clear();
+            for (size_t i = 0; i < max_batch; ++i) {
+                pending.push_back(engine.verify(gpk, batch_messages[i], batch_sigmas[i]));
+            }
+            for (auto& result : pending) {
+                result.get();
+            }
+        }, max_batch);
+    }
+
+
+    // =====================================================================
+    // SECTION 9: Member Registry Lookup
+    // =====================================================================
+    const size_t registry_members = 100000;
+    bench.section("Member Registry (" + std::to_string(registry_members) + " members)");
+
+    {
+        std::vector<ecgroup::G1Point> credentials;
+        credentials.reserve(registry_members);
+        ecgroup::G1Point step = ecgroup::G1Point::get_random();
+        ecgroup::G1Point cred = step;
+        for (size_t i = 0; i < registry_members; ++i) {
+            credentials.push_back(cred);
+            cred = cred.add(step);
+        }
+
+        bench.run("Registry Append", [&]() {
+            bbsgs::MemberRegistry fresh(registry_members);
+            for (size_t i = 0; i < registry_members; ++i) {
+                fresh.add(credentials[i], i);
+            }
+        }, registry_members);
+
+        bbsgs::MemberRegistry registry(registry_members);
+        for (size_t i = 0; i < registry_members; ++i) {
+            registry.add(credentials[i], i);
+        }
+
+        size_t idx = 0;
+        bench.run("Registry Lookup", [&]() {
+            uint64_t id;
+            registry.find(credentials[idx], id);
+            idx = (idx + 7919) % registry_members;
+        });
+    }
+
+    // =====================================================================
+    // SECTION 10: Bulk Key Issuance
+    // =====================================================================
+    bench.section("Bulk Key Issuance");
+
+    {
+        bbsgs::PreparedGroupPublicKey pgpk(gpk);
+        // Serializing each key is part of the job, as in a real onboarding pipeline
+        auto sink = [](size_t, const bbsgs::UserSecretKey& k) {
+            uint8_t out[bbsgs::UserSecretKey::SERIALIZED_SIZE];
+            k.write_to(out);
+            return true;
+        };
+
+        const size_t loop_keys = 1000;
+        bench.run("User Keygen + Serialize (loop, n=1000)", [&]() {
+            for (size_t i = 0; i < loop_keys; ++i) {
+                sink(i, bbsgs::bbs04_user_keygen(isk, gpk));
+            }
+        }, loop_keys);
+        bench.run("Keygen Batch (1 thread, n=1000)", [&]() {
+            bbsgs::bbs04_user_keygen_batch(isk, pgpk, loop_keys, sink, 1);
+        }, loop_keys);
+
+        for (size_t n = 1000; n <= max_keys; n *= 10) {
+            bench.run_fanout("Keygen Batch (all cores, n=" + std::to_string(n) + ")", [&]() {
+                bbsgs::bbs04_user_keygen_batch(isk, pgpk, n, sink);
+            }, n);
+        }
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::cerr << "cannot write " << json_path << std::endl;
+            return 1;
+        }
+        bench.write_json(out);
+        std::cout << "\nWrote " << bench.results().size() << " results to " << json_path << std::endl;
+    }
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+#!/bin/sh
+# Benchmarks BN254 and BLS12-381 side by side.
+#
+# mcl holds one curve per process, so this configures and builds one directory per
+# curve, runs the benchmarks in each with --json, and joins the two result files
+# into one table of p50 latencies. Extra arguments go to both benchmark runs.
+#
+#   benchmarks/compare_curves.sh [BUILD_ROOT] [-- BENCHMARK ARGS...]
+set -e
+
+src_dir=$(cd "$(dirname "$0")/.." && pwd)
+build_root=build-curves
+if [ $# -gt 0 ] && [ "$1" != "--" ]; then
+    build_root=$1
+    shift
+fi
+[ "${1-}" = "--" ] && shift
+
+for curve in BN254 BLS12_381; do
+    build_dir="$build_root/$curve"
+    cmake -S "$src_dir" -B "$build_dir" -DCMAKE_BUILD_TYPE=Release -DBBSGS_CURVE=$curve \
+        -DBUILD_BBSGS_TESTING=OFF
+    cmake --build "$build_dir" --target run_bbsgs_benchmarks -j"$(nproc 2>/dev/null || echo 4)"
+    "$build_dir/benchmarks/run_bbsgs_benchmarks" --json "$build_root/$curve.json" "$@"
+done
+
+# One result per line in the JSON; key on section, name, threads and pinning
+awk '
+    function field(key,    s) {
+        s = $0
+        if (!match(s, "\"" key "\": (\"[^\"]*\"|[^,}]*)")) return ""
+        s = substr(s, RSTART + length(key) + 4, RLENGTH - length(key) - 4)
+        gsub(/"/, "", s)
+        return s
+    }
+    /"name":/ {
+        key = field("section") " / " field("name") " [" field("threads") "t" (field("pinned") == "true" ? ", pinned" : "") "]"
+        if (FILENAME == bn_file) {
+            bn[key] = field("p50_ns")
+            order[++n] = key
+        } else {
+            bls[key] = field("p50_ns")
+        }
+    }
+    END {
+        printf "%-72s %14s %14s %8s\n", "benchmark (p50)", "BN254 ms", "BLS12_381 ms", "ratio"
+        for (i = 1; i <= n; ++i) {
+            k = order[i]
+            if (!(k in bls)) continue
+            printf "%-72s %14.6f %14.6f %8.2f\n", k, bn[k] / 1e6, bls[k] / 1e6, (bn[k] > 0 ? bls[k] / bn[k] : 0)
+        }
+    }
+' bn_file="$build_root/BN254.json" "$build_root/BN254.json" "$build_root/BLS12_381.json"
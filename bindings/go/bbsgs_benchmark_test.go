@@ -1,6 +1,7 @@
 package bbsgs
 
 import (
+    "fmt"
     "testing"
 )
 
@@ -165,3 +166,142 @@ func BenchmarkG1Mul(b *testing.B) {
         }
     }
 }
+
+// Handle-based and batched benchmarks
+func setupHandles(b *testing.B) (*GroupKey, *UserKey) {
+    gpk, _, isk, err := Setup()
+    if err != nil {
+        b.Fatalf("Setup failed: %v", err)
+    }
+    usk, err := UserKeygen(gpk, isk)
+    if err != nil {
+        b.Fatalf("UserKeygen failed: %v", err)
+    }
+    gk, err := NewGroupKey(gpk)
+    if err != nil {
+        b.Fatalf("NewGroupKey failed: %v", err)
+    }
+    uk, err := NewUserKey(gk, usk)
+    if err != nil {
+        b.Fatalf("NewUserKey failed: %v", err)
+    }
+    return gk, uk
+}
+
+func BenchmarkSignHandle(b *testing.B) {
+    gk, uk := setupHandles(b)
+    msg := []byte("benchmark message")
+    b.ResetTimer()
+    for i := 0; i < b.N; i++ {
+        if _, err := gk.Sign(uk, msg); err != nil {
+            b.Fatalf("GroupKey.Sign failed: %v", err)
+        }
+    }
+}
+
+func BenchmarkVerifyHandle(b *testing.B) {
+    gk, uk := setupHandles(b)
+    msg := []byte("benchmark message")
+    sig, err := gk.Sign(uk, msg)
+    if err != nil {
+        b.Fatalf("GroupKey.Sign failed: %v", err)
+    }
+    b.ResetTimer()
+    for i := 0; i < b.N; i++ {
+        if !gk.Verify(sig, msg) {
+            b.Fatal("GroupKey.Verify returned false")
+        }
+    }
+}
+
+func BenchmarkVerifyParallel(b *testing.B) {
+    gk, uk := setupHandles(b)
+    msg := []byte("benchmark message")
+    sig, err := gk.Sign(uk, msg)
+    if err != nil {
+        b.Fatalf("GroupKey.Sign failed: %v", err)
+    }
+    b.ResetTimer()
+    b.RunParallel(func(pb *testing.PB) {
+        for pb.Next() {
+            if !gk.Verify(sig, msg) {
+                b.Error("GroupKey.Verify returned false")
+                return
+            }
+        }
+    })
+}
+
+func BenchmarkSignParallel(b *testing.B) {
+    gk, uk := setupHandles(b)
+    msg := []byte("benchmark message")
+    b.ResetTimer()
+    b.RunParallel(func(pb *testing.PB) {
+        for pb.Next() {
+            if _, err := gk.Sign(uk, msg); err != nil {
+                b.Errorf("GroupKey.Sign failed: %v", err)
+                return
+            }
+        }
+    })
+}
+
+// Reported per signature, so the numbers compare directly with BenchmarkVerifyHandle.
+func BenchmarkVerifyBatch(b *testing.B) {
+    gk, uk := setupHandles(b)
+    for _, n := range []int{1, 8, 64, 512} {
+        msgs := make([][]byte, n)
+        for i := range msgs {
+            msgs[i] = []byte(fmt.Sprintf("benchmark message %d", i))
+        }
+        sigs, err := gk.SignBatch(uk, msgs)
+        if err != nil {
+            b.Fatalf("SignBatch failed: %v", err)
+        }
+        b.Run(fmt.Sprintf("n=%d", n), func(b *testing.B) {
+            for i := 0; i < b.N; i += n {
+                if _, ok, err := gk.VerifyBatch(sigs, msgs); err != nil || !ok {
+                    b.Fatalf("VerifyBatch failed: %v", err)
+                }
+            }
+        })
+    }
+}
+
+func BenchmarkSignBatch(b *testing.B) {
+    gk, uk := setupHandles(b)
+    for _, n := range []int{1, 8, 64, 512} {
+        msgs := make([][]byte, n)
+        for i := range msgs {
+            msgs[i] = []byte(fmt.Sprintf("benchmark message %d", i))
+        }
+        b.Run(fmt.Sprintf("n=%d", n), func(b *testing.B) {
+            for i := 0; i < b.N; i += n {
+                if _, err := gk.SignBatch(uk, msgs); err != nil {
+                    b.Fatalf("SignBatch failed: %v", err)
+                }
+            }
+        })
+    }
+}
+
+func BenchmarkUserKeygenBatch(b *testing.B) {
+    gpk, _, isk, err := Setup()
+    if err != nil {
+        b.Fatalf("Setup failed: %v", err)
+    }
+    gk, err := NewGroupKey(gpk)
+    if err != nil {
+        b.Fatalf("NewGroupKey failed: %v", err)
+    }
+    for _, n := range []int{1000, 10000, 100000, 1000000} {
+        b.Run(fmt.Sprintf("n=%d", n), func(b *testing.B) {
+            for i := 0; i < b.N; i += n {
+                err := gk.UserKeygenBatch(isk, n, 0, func(int, []byte) bool { return true })
+                if err != nil {
+                    b.Fatalf("UserKeygenBatch failed: %v", err)
+                }
+            }
+        })
+    }
+}
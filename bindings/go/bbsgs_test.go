@@ -70,6 +70,80 @@ func TestBBS04EndToEnd(t *testing.T) {
     }
 }
 
+func TestGroupKeyHandles(t *testing.T) {
+    InitPairing()
+
+    gpk, osk, isk, err := Setup()
+    if err != nil {
+        t.Fatalf("Setup failed: %v", err)
+    }
+    usk, err := UserKeygen(gpk, isk)
+    if err != nil {
+        t.Fatalf("UserKeygen failed: %v", err)
+    }
+
+    gk, err := NewGroupKey(gpk)
+    if err != nil {
+        t.Fatalf("NewGroupKey failed: %v", err)
+    }
+    defer gk.Close()
+    uk, err := NewUserKey(gk, usk)
+    if err != nil {
+        t.Fatalf("NewUserKey failed: %v", err)
+    }
+    defer uk.Close()
+    ok, err := NewOpenerKey(osk)
+    if err != nil {
+        t.Fatalf("NewOpenerKey failed: %v", err)
+    }
+    defer ok.Close()
+
+    if _, err := NewGroupKey(gpk[:len(gpk)-1]); err == nil {
+        t.Fatal("NewGroupKey accepted a truncated key")
+    }
+
+    msg := []byte("hello")
+    sig, err := gk.Sign(uk, msg)
+    if err != nil || len(sig) != SignatureSize {
+        t.Fatalf("GroupKey.Sign failed: %v", err)
+    }
+    if !gk.Verify(sig, msg) || !Verify(gpk, sig, msg) {
+        t.Fatal("GroupKey.Verify returned false")
+    }
+    credA, err := gk.Open(ok, sig)
+    if err != nil || !equalBytes(credA, usk[:CredentialSize]) {
+        t.Fatalf("GroupKey.Open did not return the signer's credential: %v", err)
+    }
+
+    sigV2, err := gk.SignV2(uk, msg)
+    if err != nil || len(sigV2) != SignatureV2Size || sigV2[0] != 2 {
+        t.Fatalf("GroupKey.SignV2 failed: %v", err)
+    }
+    if !gk.Verify(sigV2, msg) || !Verify(gpk, sigV2, msg) {
+        t.Fatal("GroupKey.Verify rejected a V2 signature")
+    }
+    credA, err = gk.Open(ok, sigV2)
+    if err != nil || !equalBytes(credA, usk[:CredentialSize]) {
+        t.Fatalf("GroupKey.Open did not open a V2 signature: %v", err)
+    }
+
+    msgs := [][]byte{[]byte("a"), []byte("bb"), {}, []byte("dddd")}
+    sigs, err := gk.SignBatch(uk, msgs)
+    if err != nil || len(sigs) != len(msgs) {
+        t.Fatalf("SignBatch failed: %v", err)
+    }
+    results, allValid, err := gk.VerifyBatch(sigs, msgs)
+    if err != nil || !allValid {
+        t.Fatalf("VerifyBatch rejected valid signatures: %v %v", results, err)
+    }
+
+    msgs[1] = []byte("tampered")
+    results, allValid, err = gk.VerifyBatch(sigs, msgs)
+    if err != nil || allValid || results[1] || !results[0] || !results[2] || !results[3] {
+        t.Fatalf("VerifyBatch did not isolate the bad item: %v %v", results, err)
+    }
+}
+
 // equalBytes is a helper to compare two byte slices
 func equalBytes(a, b []byte) bool {
     if len(a) != len(b) {
@@ -82,3 +156,83 @@ func equalBytes(a, b []byte) bool {
     }
     return true
 }
+
+func TestMetrics(t *testing.T) {
+    InitPairing()
+
+    if err := EnableMetrics(true); err != nil {
+        t.Skipf("metrics not compiled in: %v", err)
+    }
+    defer EnableMetrics(false)
+    ResetMetrics()
+
+    gpk, _, isk, err := Setup()
+    if err != nil {
+        t.Fatalf("Setup failed: %v", err)
+    }
+    usk, err := UserKeygen(gpk, isk)
+    if err != nil {
+        t.Fatalf("UserKeygen failed: %v", err)
+    }
+    msg := []byte("metrics")
+    sig, err := Sign(gpk, usk, msg)
+    if err != nil {
+        t.Fatalf("Sign failed: %v", err)
+    }
+    if !Verify(gpk, sig, msg) {
+        t.Fatal("Verify returned false")
+    }
+
+    m := ReadMetrics()
+    if m.Sign.Count != 1 || m.Verify.Count != 1 {
+        t.Errorf("op counts = sign %d, verify %d; want 1, 1", m.Sign.Count, m.Verify.Count)
+    }
+    if m.Pairings == 0 || m.Hashes == 0 {
+        t.Errorf("expected pairings and hashes to be counted: %+v", m)
+    }
+
+    ResetMetrics()
+    if m = ReadMetrics(); m.Verify.Count != 0 {
+        t.Errorf("Verify.Count after reset = %d, want 0", m.Verify.Count)
+    }
+}
+
+func TestUserKeygenBatch(t *testing.T) {
+    InitPairing()
+
+    gpk, _, isk, err := Setup()
+    if err != nil {
+        t.Fatalf("Setup failed: %v", err)
+    }
+    gk, err := NewGroupKey(gpk)
+    if err != nil {
+        t.Fatalf("NewGroupKey failed: %v", err)
+    }
+    defer gk.Close()
+
+    keys := make([][]byte, 10)
+    err = gk.UserKeygenBatch(isk, len(keys), 2, func(i int, usk []byte) bool {
+        keys[i] = usk
+        return true
+    })
+    if err != nil {
+        t.Fatalf("UserKeygenBatch failed: %v", err)
+    }
+    for i, usk := range keys {
+        if len(usk) != UskSize || !VerifyUsk(gpk, usk) {
+            t.Fatalf("key %d is invalid", i)
+        }
+    }
+
+    calls := 0
+    err = gk.UserKeygenBatch(isk, len(keys), 2, func(int, []byte) bool {
+        calls++
+        return false
+    })
+    if err != nil || calls != 1 {
+        t.Fatalf("stopping sink: err = %v, calls = %d", err, calls)
+    }
+    if err := gk.UserKeygenBatch(isk[:len(isk)-1], 1, 1, func(int, []byte) bool { return true }); err == nil {
+        t.Fatal("UserKeygenBatch accepted a truncated issuer key")
+    }
+}
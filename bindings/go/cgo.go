@@ -3,11 +3,26 @@ package bbsgs
 /*
 #cgo pkg-config: --static bbsgs
 #include <bbsgs/bbsgs_c.h>
+#include <stdint.h>
 #include <stdlib.h>
+
+// Defined in Go (sink.go); ctx carries a cgo.Handle to the Go callback.
+extern int bbsgsGoUskSink(uintptr_t handle, size_t index, unsigned char* usk, size_t usk_len);
+
+static int bbsgs_go_usk_sink(void* ctx, size_t index, const unsigned char* usk, size_t usk_len) {
+	return bbsgsGoUskSink((uintptr_t)ctx, index, (unsigned char*)usk, usk_len);
+}
+
+static int bbsgs_go_user_keygen_batch(const bbs04_gpk_handle* gpk, const unsigned char* isk, size_t isk_len,
+                                      size_t count, size_t threads, uintptr_t handle) {
+	return bbs04_user_keygen_batch(gpk, isk, isk_len, count, threads, bbsgs_go_usk_sink, (void*)handle);
+}
 */
 import "C"
 import (
 	"errors"
+	"runtime"
+	"runtime/cgo"
 	"unsafe"
 )
 
@@ -16,6 +31,12 @@ func InitPairing() {
 	C.bbs04_init_pairing()
 }
 
+// CurveName reports the pairing curve the native library was built for,
+// "BN254" or "BLS12_381". Key and signature sizes depend on it.
+func CurveName() string {
+	return C.GoString(C.bbs04_curve_name())
+}
+
 // Setup generates the public key, opener SK, and issuer SK.
 func Setup() (gpk, osk, isk []byte, err error) {
 	var (
@@ -204,3 +225,328 @@ func G1Mul(pointBytes, scalarBytes []byte) (result []byte, err error) {
 	result = C.GoBytes(unsafe.Pointer(ptr), C.int(length))
 	return
 }
+
+// ------------------------------------------------------------------------
+// Pre-parsed key handles and batched calls
+// ------------------------------------------------------------------------
+
+// SignatureSize is the length of a V1 signature, the default format.
+const SignatureSize = C.BBS04_SIGNATURE_SIZE
+
+// SignatureV2Size is the length of a version-prefixed signature from SignV2.
+const SignatureV2Size = C.BBS04_SIGNATURE_V2_SIZE
+
+// CredentialSize is the length of an opened credential A.
+const CredentialSize = C.BBS04_CREDENTIAL_SIZE
+
+// UskSize is the length of a serialized user secret key.
+const UskSize = C.BBS04_USK_SIZE
+
+// bytesPtr returns a C view of b without copying; nil for an empty slice.
+func bytesPtr(b []byte) *C.uchar {
+	if len(b) == 0 {
+		return nil
+	}
+	return (*C.uchar)(unsafe.Pointer(&b[0]))
+}
+
+// pack lays items out back to back with their lengths, the layout the
+// native batch calls expect.
+func pack(items [][]byte) (flat []byte, lens []C.size_t) {
+	total := 0
+	for _, it := range items {
+		total += len(it)
+	}
+	flat = make([]byte, 0, total)
+	lens = make([]C.size_t, len(items))
+	for i, it := range items {
+		flat = append(flat, it...)
+		lens[i] = C.size_t(len(it))
+	}
+	return
+}
+
+// GroupKey is a group public key parsed once on the native side, together
+// with its precomputed tables. It is safe for concurrent use. Close releases
+// it early; otherwise it is released when garbage collected.
+type GroupKey struct {
+	h *C.bbs04_gpk_handle
+}
+
+// NewGroupKey parses gpk into a GroupKey.
+func NewGroupKey(gpk []byte) (*GroupKey, error) {
+	h := C.bbs04_gpk_handle_new(bytesPtr(gpk), C.size_t(len(gpk)))
+	if h == nil {
+		return nil, errors.New("bbs04_gpk_handle_new failed")
+	}
+	gk := &GroupKey{h: h}
+	runtime.SetFinalizer(gk, (*GroupKey).Close)
+	return gk, nil
+}
+
+// Close releases the native key. The GroupKey must not be used afterwards.
+func (gk *GroupKey) Close() {
+	if gk.h != nil {
+		C.bbs04_gpk_handle_free(gk.h)
+		gk.h = nil
+		runtime.SetFinalizer(gk, nil)
+	}
+}
+
+// UserKeygenBatch issues count user keys for the group on threads native
+// threads (0 = one per core) and passes each serialized key to fn together with
+// its index in the batch, so the whole batch never has to be held in memory.
+// fn is never called concurrently, but indices arrive out of order. Returning
+// false from fn stops the batch early; that is not an error.
+func (gk *GroupKey) UserKeygenBatch(isk []byte, count, threads int, fn func(index int, usk []byte) bool) error {
+	if count < 0 || threads < 0 {
+		return errors.New("bbs04_user_keygen_batch: negative count or threads")
+	}
+	h := cgo.NewHandle(fn)
+	defer h.Delete()
+	ret := C.bbsgs_go_user_keygen_batch(gk.h, bytesPtr(isk), C.size_t(len(isk)),
+		C.size_t(count), C.size_t(threads), C.uintptr_t(h))
+	runtime.KeepAlive(gk)
+	if ret != C.BBSGS_OK && ret != C.BBSGS_STOPPED {
+		return errors.New("bbs04_user_keygen_batch failed")
+	}
+	return nil
+}
+
+// UserKey is a user secret key prepared for signing under one GroupKey.
+type UserKey struct {
+	h *C.bbs04_usk_handle
+}
+
+// NewUserKey parses usk and prepares it for signing under gk.
+func NewUserKey(gk *GroupKey, usk []byte) (*UserKey, error) {
+	h := C.bbs04_usk_handle_new(gk.h, bytesPtr(usk), C.size_t(len(usk)))
+	runtime.KeepAlive(gk)
+	if h == nil {
+		return nil, errors.New("bbs04_usk_handle_new failed")
+	}
+	uk := &UserKey{h: h}
+	runtime.SetFinalizer(uk, (*UserKey).Close)
+	return uk, nil
+}
+
+// Close releases the native key. The UserKey must not be used afterwards.
+func (uk *UserKey) Close() {
+	if uk.h != nil {
+		C.bbs04_usk_handle_free(uk.h)
+		uk.h = nil
+		runtime.SetFinalizer(uk, nil)
+	}
+}
+
+// OpenerKey is a parsed opener secret key.
+type OpenerKey struct {
+	h *C.bbs04_osk_handle
+}
+
+// NewOpenerKey parses osk.
+func NewOpenerKey(osk []byte) (*OpenerKey, error) {
+	h := C.bbs04_osk_handle_new(bytesPtr(osk), C.size_t(len(osk)))
+	if h == nil {
+		return nil, errors.New("bbs04_osk_handle_new failed")
+	}
+	ok := &OpenerKey{h: h}
+	runtime.SetFinalizer(ok, (*OpenerKey).Close)
+	return ok, nil
+}
+
+// Close releases the native key. The OpenerKey must not be used afterwards.
+func (ok *OpenerKey) Close() {
+	if ok.h != nil {
+		C.bbs04_osk_handle_free(ok.h)
+		ok.h = nil
+		runtime.SetFinalizer(ok, nil)
+	}
+}
+
+// Sign produces a group signature over msg, written straight into the
+// returned slice.
+func (gk *GroupKey) Sign(uk *UserKey, msg []byte) ([]byte, error) {
+	sig := make([]byte, SignatureSize)
+	ret := C.bbs04_sign_h_into(gk.h, uk.h,
+		bytesPtr(msg), C.size_t(len(msg)),
+		bytesPtr(sig), C.size_t(len(sig)),
+	)
+	runtime.KeepAlive(gk)
+	runtime.KeepAlive(uk)
+	if ret != 0 {
+		return nil, errors.New("bbs04_sign_h_into failed")
+	}
+	return sig, nil
+}
+
+// SignV2 is like Sign but produces a version-prefixed (V2) signature, which
+// binds the version into the challenge. Verify and Open accept both formats.
+func (gk *GroupKey) SignV2(uk *UserKey, msg []byte) ([]byte, error) {
+	sig := make([]byte, SignatureV2Size)
+	ret := C.bbs04_sign_h_into_v2(gk.h, uk.h,
+		bytesPtr(msg), C.size_t(len(msg)),
+		bytesPtr(sig), C.size_t(len(sig)),
+	)
+	runtime.KeepAlive(gk)
+	runtime.KeepAlive(uk)
+	if ret != 0 {
+		return nil, errors.New("bbs04_sign_h_into_v2 failed")
+	}
+	return sig, nil
+}
+
+// Verify returns true if sig is a valid signature on msg.
+func (gk *GroupKey) Verify(sig, msg []byte) bool {
+	ret := C.bbs04_verify_h(gk.h,
+		bytesPtr(sig), C.size_t(len(sig)),
+		bytesPtr(msg), C.size_t(len(msg)),
+	)
+	runtime.KeepAlive(gk)
+	return ret == 1
+}
+
+// Open reveals the signer's credential A from sig.
+func (gk *GroupKey) Open(ok *OpenerKey, sig []byte) ([]byte, error) {
+	credA := make([]byte, CredentialSize)
+	ret := C.bbs04_open_h_into(gk.h, ok.h,
+		bytesPtr(sig), C.size_t(len(sig)),
+		bytesPtr(credA), C.size_t(len(credA)),
+	)
+	runtime.KeepAlive(gk)
+	runtime.KeepAlive(ok)
+	if ret != 0 {
+		return nil, errors.New("bbs04_open_h_into failed")
+	}
+	return credA, nil
+}
+
+// VerifyBatch verifies sigs[i] over msgs[i] in a single native call.
+// results[i] reports signature i; allValid is true if every one verified.
+func (gk *GroupKey) VerifyBatch(sigs, msgs [][]byte) (results []bool, allValid bool, err error) {
+	if len(sigs) != len(msgs) {
+		return nil, false, errors.New("VerifyBatch: sigs and msgs differ in length")
+	}
+	results = make([]bool, len(sigs))
+	if len(sigs) == 0 {
+		return results, true, nil
+	}
+	sigFlat, sigLens := pack(sigs)
+	msgFlat, msgLens := pack(msgs)
+	// The native side writes 0 or 1 per item, which is exactly Go's bool layout
+	ret := C.bbs04_verify_batch_h(gk.h, C.size_t(len(sigs)),
+		bytesPtr(sigFlat), &sigLens[0],
+		bytesPtr(msgFlat), &msgLens[0],
+		(*C.uchar)(unsafe.Pointer(&results[0])),
+	)
+	runtime.KeepAlive(gk)
+	if ret < 0 {
+		return nil, false, errors.New("bbs04_verify_batch_h failed")
+	}
+	return results, ret == 1, nil
+}
+
+// SignBatch signs every message in a single native call. The signatures
+// share one backing array and are written into it directly.
+func (gk *GroupKey) SignBatch(uk *UserKey, msgs [][]byte) ([][]byte, error) {
+	sigs := make([][]byte, len(msgs))
+	if len(msgs) == 0 {
+		return sigs, nil
+	}
+	msgFlat, msgLens := pack(msgs)
+	out := make([]byte, len(msgs)*SignatureSize)
+	ret := C.bbs04_sign_batch_h(gk.h, uk.h, C.size_t(len(msgs)),
+		bytesPtr(msgFlat), &msgLens[0],
+		bytesPtr(out), C.size_t(len(out)),
+	)
+	runtime.KeepAlive(gk)
+	runtime.KeepAlive(uk)
+	if ret != 0 {
+		return nil, errors.New("bbs04_sign_batch_h failed")
+	}
+	for i := range sigs {
+		sigs[i] = out[i*SignatureSize : (i+1)*SignatureSize : (i+1)*SignatureSize]
+	}
+	return sigs, nil
+}
+
+// OpMetrics describes one timed operation (sign, verify or open).
+type OpMetrics struct {
+	Count uint64
+	// TotalNs is the summed latency of all Count calls.
+	TotalNs uint64
+	// Buckets[i] counts calls that took [2^i, 2^(i+1)) ns; the last bucket
+	// also counts every slower call.
+	Buckets [C.BBS04_LATENCY_BUCKETS]uint64
+}
+
+// Metrics is a point-in-time copy of the library's counters, summed over
+// all threads.
+type Metrics struct {
+	Pairings       uint64
+	G1Muls         uint64
+	G2Muls         uint64
+	GTExps         uint64
+	Hashes         uint64
+	BytesHashed    uint64
+	DecodeFailures uint64
+	Sign           OpMetrics
+	Verify         OpMetrics
+	Open           OpMetrics
+}
+
+// EnableMetrics starts or stops collection. It fails when asked to start and
+// the native library was built without metrics.
+func EnableMetrics(on bool) error {
+	flag := C.int(0)
+	if on {
+		flag = 1
+	}
+	if C.bbs04_metrics_set_enabled(flag) != 0 {
+		return errors.New("bbsgs was built without metrics")
+	}
+	return nil
+}
+
+// ReadMetrics returns the current totals.
+func ReadMetrics() Metrics {
+	var m C.bbs04_metrics
+	C.bbs04_metrics_snapshot(&m)
+
+	op := func(i int) OpMetrics {
+		o := OpMetrics{Count: uint64(m.op_count[i]), TotalNs: uint64(m.op_latency_sum_ns[i])}
+		for b := range o.Buckets {
+			o.Buckets[b] = uint64(m.op_latency_buckets[i][b])
+		}
+		return o
+	}
+	return Metrics{
+		Pairings:       uint64(m.counters[C.BBS04_METRIC_PAIRINGS]),
+		G1Muls:         uint64(m.counters[C.BBS04_METRIC_G1_MULS]),
+		G2Muls:         uint64(m.counters[C.BBS04_METRIC_G2_MULS]),
+		GTExps:         uint64(m.counters[C.BBS04_METRIC_GT_EXPS]),
+		Hashes:         uint64(m.counters[C.BBS04_METRIC_HASHES]),
+		BytesHashed:    uint64(m.counters[C.BBS04_METRIC_BYTES_HASHED]),
+		DecodeFailures: uint64(m.counters[C.BBS04_METRIC_DECODE_FAILURES]),
+		Sign:           op(C.BBS04_OP_SIGN),
+		Verify:         op(C.BBS04_OP_VERIFY),
+		Open:           op(C.BBS04_OP_OPEN),
+	}
+}
+
+// ResetMetrics zeroes every counter and histogram.
+func ResetMetrics() {
+	C.bbs04_metrics_reset()
+}
+
+// SetRandomSeed makes the library's randomness deterministic, for reproducible
+// tests and benchmarks. Never use it for real keys, and do not call it while
+// other goroutines are signing.
+func SetRandomSeed(seed uint64) {
+	C.bbs04_random_set_seed(C.uint64_t(seed))
+}
+
+// ClearRandomSeed returns to randomness seeded from the operating system.
+func ClearRandomSeed() {
+	C.bbs04_random_clear_seed()
+}
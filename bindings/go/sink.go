@@ -0,0 +1,22 @@
+package bbsgs
+
+/*
+#include <stddef.h>
+#include <stdint.h>
+*/
+import "C"
+import (
+	"runtime/cgo"
+	"unsafe"
+)
+
+// Called by the native bulk keygen for every issued key; see UserKeygenBatch.
+//
+//export bbsgsGoUskSink
+func bbsgsGoUskSink(handle C.uintptr_t, index C.size_t, usk *C.uchar, uskLen C.size_t) C.int {
+	fn := cgo.Handle(handle).Value().(func(int, []byte) bool)
+	if fn(int(index), C.GoBytes(unsafe.Pointer(usk), C.int(uskLen))) {
+		return 0
+	}
+	return 1
+}
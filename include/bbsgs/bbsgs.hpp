@@ -4,5 +4,8 @@
 #include "../../src/keygen.hpp"
 #include "../../src/helpers.hpp"
 #include "../../src/signature.hpp"
+#include "../../src/presign.hpp"
+#include "../../src/registry.hpp"
+#include "../../src/engine.hpp"
 
 #endif // BBSGS_HPP
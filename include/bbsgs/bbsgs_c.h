@@ -2,6 +2,9 @@
 #define BBSGS_C_H
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include "bbsgs/config.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -9,10 +12,34 @@ extern "C" {
 
 #define BBSGS_OK  0
 #define BBSGS_ERR (-1)
+// A caller's callback asked the operation to stop early; not an error.
+#define BBSGS_STOPPED 1
+
+// Serialized sizes of every value the library outputs, for sizing caller buffers.
+// They depend on the curve the library was built for (BBSGS_CURVE_NAME).
+#define BBS04_SCALAR_SIZE     32
+#if defined(BBSGS_CURVE_BLS12_381)
+#define BBS04_G1_SIZE         48
+#define BBS04_G2_SIZE         96
+#else
+#define BBS04_G1_SIZE         32
+#define BBS04_G2_SIZE         64
+#endif
+#define BBS04_GPK_SIZE        (4 * BBS04_G1_SIZE + 2 * BBS04_G2_SIZE)
+#define BBS04_OSK_SIZE        (2 * BBS04_SCALAR_SIZE)
+#define BBS04_ISK_SIZE        BBS04_SCALAR_SIZE
+#define BBS04_USK_SIZE        (BBS04_G1_SIZE + BBS04_SCALAR_SIZE)
+#define BBS04_SIGNATURE_SIZE  (3 * BBS04_G1_SIZE + 6 * BBS04_SCALAR_SIZE)
+#define BBS04_CREDENTIAL_SIZE BBS04_G1_SIZE
+// Version-prefixed signatures; accepted by every verify and open call.
+#define BBS04_SIGNATURE_V2_SIZE (BBS04_SIGNATURE_SIZE + 1)
 
 // Initialize the underlying pairing library. Must be called once.
 void bbs04_init_pairing();
 
+// Name of the pairing curve the library was built for: "BN254" or "BLS12_381".
+const char* bbs04_curve_name();
+
 // Setup generates the main cryptographic keys.
 // The caller is responsible for freeing all output buffers using free_byte_buffer.
 int bbs04_setup_c(
@@ -37,12 +64,14 @@ int bbs04_sign_c(
 );
 
 // Check if generated user secret key is valid for group parameters.
+// Returns 1 for valid and 0 otherwise, including when an input cannot be parsed.
 int bbs04_verify_usk_c(
     const unsigned char* gpk_in, size_t gpk_len_in,
     const unsigned char* usk_in, size_t usk_len_in
 );
 
-// Verify checks if a signature is valid. Returns 1 for valid, 0 for invalid.
+// Verify checks if a signature is valid. Returns 1 for valid and 0 otherwise,
+// including when an input cannot be parsed. Inputs get full point validation.
 int bbs04_verify_c(
     const unsigned char* gpk_in, size_t gpk_len_in,
     const unsigned char* sig_in, size_t sig_len_in,
@@ -57,6 +86,165 @@ int bbs04_open_c(
     unsigned char** credential_A_out, size_t* credential_A_len_out
 );
 
+// ------------------------------------------------------------------------
+// Pre-parsed key handles
+// ------------------------------------------------------------------------
+//
+// The byte-based calls above parse and validate every key on every call.
+// A handle is parsed once and carries the precomputed tables for its key,
+// so repeated sign/verify/open calls only pay for the operation itself.
+// Handles are immutable and may be shared between threads; each one must
+// be released exactly once with its matching free function.
+
+typedef struct bbs04_gpk_handle bbs04_gpk_handle;
+typedef struct bbs04_usk_handle bbs04_usk_handle;
+typedef struct bbs04_osk_handle bbs04_osk_handle;
+
+// Parse a group public key and precompute its tables. Returns NULL on malformed input.
+bbs04_gpk_handle* bbs04_gpk_handle_new(const unsigned char* gpk_in, size_t gpk_len_in);
+
+// Parse a user secret key for the given group. Returns NULL on malformed input.
+bbs04_usk_handle* bbs04_usk_handle_new(
+    const bbs04_gpk_handle* gpk,
+    const unsigned char* usk_in, size_t usk_len_in
+);
+
+// Parse an opener secret key. Returns NULL on malformed input.
+bbs04_osk_handle* bbs04_osk_handle_new(const unsigned char* osk_in, size_t osk_len_in);
+
+void bbs04_gpk_handle_free(bbs04_gpk_handle* gpk);
+void bbs04_usk_handle_free(bbs04_usk_handle* usk);
+void bbs04_osk_handle_free(bbs04_osk_handle* osk);
+
+// Handle-based counterpart of bbs04_sign_c.
+int bbs04_sign_h(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_usk_handle* usk,
+    const unsigned char* msg_in, size_t msg_len_in,
+    unsigned char** sig_out, size_t* sig_len_out
+);
+
+// Handle-based counterpart of bbs04_verify_c. Returns 1 for valid and 0 otherwise,
+// including for an unparsable signature or a NULL handle.
+int bbs04_verify_h(
+    const bbs04_gpk_handle* gpk,
+    const unsigned char* sig_in, size_t sig_len_in,
+    const unsigned char* msg_in, size_t msg_len_in
+);
+
+// Handle-based counterpart of bbs04_open_c.
+int bbs04_open_h(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_osk_handle* osk,
+    const unsigned char* sig_in, size_t sig_len_in,
+    unsigned char** credential_A_out, size_t* credential_A_len_out
+);
+
+// ------------------------------------------------------------------------
+// Batched calls
+// ------------------------------------------------------------------------
+//
+// One call for a whole slice of items, so language bindings cross the FFI
+// boundary once per batch. Item i of a packed input starts where item i-1
+// ended: sigs_in holds count signatures back to back with their lengths in
+// sig_lens_in, and likewise for messages.
+
+// Verifies count signatures. results_out[i] receives 1 if signature i is valid
+// and 0 if it is invalid or cannot be parsed. Returns 1 if every signature is
+// valid, 0 otherwise, and BBSGS_ERR on invalid arguments.
+int bbs04_verify_batch_h(
+    const bbs04_gpk_handle* gpk,
+    size_t count,
+    const unsigned char* sigs_in, const size_t* sig_lens_in,
+    const unsigned char* msgs_in, const size_t* msg_lens_in,
+    unsigned char* results_out
+);
+
+// Signs count messages. Signature i is written to
+// sigs_out + i * BBS04_SIGNATURE_SIZE; sigs_cap must be at least
+// count * BBS04_SIGNATURE_SIZE.
+int bbs04_sign_batch_h(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_usk_handle* usk,
+    size_t count,
+    const unsigned char* msgs_in, const size_t* msg_lens_in,
+    unsigned char* sigs_out, size_t sigs_cap
+);
+
+// Receives key index of a bulk issuance, serialized in usk_len
+// (BBS04_USK_SIZE) bytes that are only valid during the call. Returns 0 to
+// continue and nonzero to stop the batch.
+typedef int (*bbs04_usk_sink)(void* ctx, size_t index, const unsigned char* usk, size_t usk_len);
+
+// Issues count user keys on num_threads threads (0 = one per core) and streams
+// each one to sink, so no buffer for the whole batch is needed. Calls to sink
+// never overlap but arrive in no particular index order. Returns BBSGS_OK once
+// every key was delivered, BBSGS_STOPPED if sink asked to stop and BBSGS_ERR on
+// invalid input.
+int bbs04_user_keygen_batch(
+    const bbs04_gpk_handle* gpk,
+    const unsigned char* isk_in, size_t isk_len_in,
+    size_t count, size_t num_threads,
+    bbs04_usk_sink sink, void* ctx
+);
+
+// ------------------------------------------------------------------------
+// Caller-provided output buffers
+// ------------------------------------------------------------------------
+//
+// Same operations as above, but the results are written into buffers owned by
+// the caller and nothing is returned to free. Each *_out must hold at least the
+// matching BBS04_*_SIZE bytes, given in *_cap; a smaller buffer is an error.
+
+int bbs04_setup_into(
+    unsigned char* gpk_out, size_t gpk_cap,
+    unsigned char* osk_out, size_t osk_cap,
+    unsigned char* isk_out, size_t isk_cap
+);
+
+int bbs04_user_keygen_into(
+    const unsigned char* gpk_in, size_t gpk_len_in,
+    const unsigned char* isk_in, size_t isk_len_in,
+    unsigned char* usk_out, size_t usk_cap
+);
+
+int bbs04_sign_into(
+    const unsigned char* gpk_in, size_t gpk_len_in,
+    const unsigned char* usk_in, size_t usk_len_in,
+    const unsigned char* msg_in, size_t msg_len_in,
+    unsigned char* sig_out, size_t sig_cap
+);
+
+int bbs04_open_into(
+    const unsigned char* gpk_in, size_t gpk_len_in,
+    const unsigned char* osk_in, size_t osk_len_in,
+    const unsigned char* sig_in, size_t sig_len_in,
+    unsigned char* credential_A_out, size_t credential_A_cap
+);
+
+int bbs04_sign_h_into(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_usk_handle* usk,
+    const unsigned char* msg_in, size_t msg_len_in,
+    unsigned char* sig_out, size_t sig_cap
+);
+
+// Like bbs04_sign_h_into, but writes a version-prefixed (V2) signature of
+// exactly BBS04_SIGNATURE_V2_SIZE bytes.
+int bbs04_sign_h_into_v2(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_usk_handle* usk,
+    const unsigned char* msg_in, size_t msg_len_in,
+    unsigned char* sig_out, size_t sig_cap
+);
+
+int bbs04_open_h_into(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_osk_handle* osk,
+    const unsigned char* sig_in, size_t sig_len_in,
+    unsigned char* credential_A_out, size_t credential_A_cap
+);
+
 // ------------------------------------------------------------------------
 // EC scalar & G1 helpers
 // ------------------------------------------------------------------------
@@ -88,6 +276,66 @@ int ec_g1_mul(
     unsigned char** point_out, size_t* point_len_out
 );
 
+// ------------------------------------------------------------------------
+// Metrics
+// ------------------------------------------------------------------------
+//
+// Operation counters and latency histograms, summed over all threads. Nothing
+// is collected until bbs04_metrics_set_enabled(1), and nothing at all when the
+// library was built with BBSGS_ENABLE_METRICS=OFF.
+
+// Indices into bbs04_metrics.counters
+#define BBS04_METRIC_PAIRINGS         0 // Miller loops; a multi-pairing counts one per pair
+#define BBS04_METRIC_G1_MULS          1
+#define BBS04_METRIC_G2_MULS          2
+#define BBS04_METRIC_GT_EXPS          3
+#define BBS04_METRIC_HASHES           4
+#define BBS04_METRIC_BYTES_HASHED     5
+#define BBS04_METRIC_DECODE_FAILURES  6
+#define BBS04_METRIC_COUNTERS         7
+
+// Indices of the timed operations. Batch calls record one sample per item.
+#define BBS04_OP_SIGN    0
+#define BBS04_OP_VERIFY  1
+#define BBS04_OP_OPEN    2
+#define BBS04_OPS        3
+
+// op_latency_buckets[op][i] counts calls that took [2^i, 2^(i+1)) nanoseconds;
+// the last bucket also counts every slower call.
+#define BBS04_LATENCY_BUCKETS 32
+
+typedef struct bbs04_metrics {
+    uint64_t counters[BBS04_METRIC_COUNTERS];
+    uint64_t op_count[BBS04_OPS];
+    uint64_t op_latency_sum_ns[BBS04_OPS];
+    uint64_t op_latency_buckets[BBS04_OPS][BBS04_LATENCY_BUCKETS];
+} bbs04_metrics;
+
+// Starts (enabled != 0) or stops collection. Returns BBSGS_ERR when asked to
+// start in a build without metrics.
+int bbs04_metrics_set_enabled(int enabled);
+
+// Fills *out with the current totals.
+int bbs04_metrics_snapshot(bbs04_metrics* out);
+
+// Zeroes every counter and histogram.
+void bbs04_metrics_reset(void);
+
+// ------------------------------------------------------------------------
+// Randomness
+// ------------------------------------------------------------------------
+//
+// Every thread draws from its own ChaCha20 generator seeded from the OS.
+
+// Makes all further randomness deterministic, for reproducible tests and
+// benchmarks; never use it for real keys. Threads get distinct streams in the
+// order they first draw, the calling thread first. Must not be called while
+// other threads are signing.
+void bbs04_random_set_seed(uint64_t seed);
+
+// Returns to OS-seeded generators.
+void bbs04_random_clear_seed(void);
+
 // Frees any buffer previously allocated by the library.
 void free_byte_buffer(unsigned char* buf);
 
@@ -2,5 +2,6 @@
 #define BBSGS_EC_HPP
 
 #include "../../src/ecgroup.hpp"
+#include "../../src/random.hpp"
 
 #endif // BBSGS_EC_HPP
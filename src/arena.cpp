@@ -0,0 +1,52 @@
+#include "arena.hpp"
+#include <algorithm>
+
+namespace ecgroup {
+
+    ScratchArena& ScratchArena::local() {
+        thread_local ScratchArena arena;
+        return arena;
+    }
+
+    void* ScratchArena::allocate(size_t bytes, size_t align) {
+        if (!buffer) {
+            size = INITIAL_CAPACITY;
+            buffer.reset(new uint8_t[size]);
+        }
+        // new[] storage is aligned for every fundamental type, so offsets suffice
+        size_t offset = (used + align - 1) & ~(align - 1);
+        if (offset + bytes <= size) {
+            used = offset + bytes;
+            return buffer.get() + offset;
+        }
+
+        // Does not fit: serve it from its own block and remember to grow later
+        overflow.emplace_back(new uint8_t[bytes + align]);
+        overflow_bytes += bytes + align;
+        uintptr_t raw = reinterpret_cast<uintptr_t>(overflow.back().get());
+        return reinterpret_cast<void*>((raw + align - 1) & ~uintptr_t(align - 1));
+    }
+
+    void ScratchArena::release(size_t saved, size_t scope_depth) {
+        used = saved;
+        depth = scope_depth;
+        if (scope_depth != 0 || overflow.empty()) {
+            return;
+        }
+        // Nothing is live any more: replace buffer and overflow blocks with one
+        // buffer that would have held them all, up to the retention cap.
+        size_t needed = size + overflow_bytes;
+        size_t grown = size;
+        while (grown < needed && grown < MAX_RETAINED_CAPACITY) {
+            grown *= 2;
+        }
+        grown = std::min(grown, MAX_RETAINED_CAPACITY);
+        overflow.clear();
+        overflow_bytes = 0;
+        if (grown != size) {
+            size = grown;
+            buffer.reset(new uint8_t[size]);
+        }
+    }
+
+} // namespace ecgroup
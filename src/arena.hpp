@@ -0,0 +1,81 @@
+#ifndef SHIM_ARENA_HPP
+#define SHIM_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace ecgroup {
+
+    /**
+     * Per-thread bump allocator for the temporaries of one operation (multi-scalar
+     * multiplication inputs, Miller loop arguments, ...).
+     *
+     * Memory is taken inside a ScratchArena::Scope and handed back all at once when the
+     * scope ends. When an operation outgrows the buffer, the excess is served from
+     * overflow blocks; the outermost scope then folds them into one larger buffer, so
+     * after the first call of a given size, repeated calls do not touch the heap.
+     * The buffer never grows past MAX_RETAINED_CAPACITY: larger operations keep being
+     * served from overflow blocks, which the outermost scope frees, so one huge batch
+     * does not pin its peak memory to a long-lived thread.
+     * Only trivially destructible types may live here, as nothing is ever destroyed.
+     */
+    class ScratchArena {
+    public:
+        static constexpr size_t INITIAL_CAPACITY = 16 * 1024;
+        static constexpr size_t MAX_RETAINED_CAPACITY = 4 * 1024 * 1024;
+
+        // The calling thread's arena.
+        static ScratchArena& local();
+
+        class Scope {
+        public:
+            explicit Scope(ScratchArena& arena = ScratchArena::local())
+                : arena(arena), saved(arena.used), depth(arena.depth++) {}
+            ~Scope() { arena.release(saved, depth); }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            ScratchArena& arena;
+            size_t saved;
+            size_t depth;
+        };
+
+        // Default-constructs n objects of type T. Valid until the enclosing Scope ends.
+        template <class T>
+        T* make_array(size_t n) {
+            static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+            T* p = static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+            for (size_t i = 0; i < n; ++i) {
+                new (p + i) T();
+            }
+            return p;
+        }
+
+        size_t capacity() const { return size; }
+
+        ScratchArena() = default;
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+    private:
+        std::unique_ptr<uint8_t[]> buffer;
+        size_t size = 0;
+        size_t used = 0;
+        size_t depth = 0;
+        std::vector<std::unique_ptr<uint8_t[]>> overflow;
+        size_t overflow_bytes = 0;
+
+        void* allocate(size_t bytes, size_t align);
+        void release(size_t saved, size_t scope_depth);
+    };
+
+} // namespace ecgroup
+
+#endif // SHIM_ARENA_HPP
@@ -1,7 +1,12 @@
 #include "bbsgs/bbsgs_c.h"
 #include "bbsgs/bbsgs.hpp"
+#include "metrics.hpp"
+#include "random.hpp"
+#include <algorithm>
 #include <vector>
 #include <cstring>
+#include <iterator>
+#include <stdexcept>
 #include <string>
 
 // Helper to copy a C++ Bytes vector to a newly allocated C buffer
@@ -11,10 +16,30 @@ void copy_to_c_buf(const ecgroup::Bytes& vec, unsigned char** buf_out, size_t* l
     memcpy(*buf_out, vec.data(), *len_out);
 }
 
+static_assert(BBS04_SCALAR_SIZE == ecgroup::FR_SERIALIZED_SIZE, "scalar size mismatch");
+static_assert(BBS04_G1_SIZE == ecgroup::G1_SERIALIZED_SIZE, "G1 size mismatch");
+static_assert(BBS04_G2_SIZE == ecgroup::G2_SERIALIZED_SIZE, "G2 size mismatch");
+static_assert(BBS04_GPK_SIZE == bbsgs::GroupPublicKey::SERIALIZED_SIZE, "gpk size mismatch");
+static_assert(BBS04_OSK_SIZE == bbsgs::OpenerSecretKey::SERIALIZED_SIZE, "osk size mismatch");
+static_assert(BBS04_ISK_SIZE == bbsgs::IssuerSecretKey::SERIALIZED_SIZE, "isk size mismatch");
+static_assert(BBS04_USK_SIZE == bbsgs::UserSecretKey::SERIALIZED_SIZE, "usk size mismatch");
+static_assert(BBS04_SIGNATURE_SIZE == bbsgs::GroupSignature::SERIALIZED_SIZE, "signature size mismatch");
+
+static_assert(BBS04_METRIC_COUNTERS == ecgroup::metrics::COUNTER_COUNT, "metric counter mismatch");
+static_assert(BBS04_METRIC_DECODE_FAILURES == static_cast<size_t>(ecgroup::metrics::Counter::DecodeFailures),
+              "metric counter order mismatch");
+static_assert(BBS04_OPS == ecgroup::metrics::OP_COUNT, "metric op mismatch");
+static_assert(BBS04_OP_OPEN == static_cast<size_t>(ecgroup::metrics::Op::Open), "metric op order mismatch");
+static_assert(BBS04_LATENCY_BUCKETS == ecgroup::metrics::LATENCY_BUCKETS, "latency bucket mismatch");
+
 void bbs04_init_pairing() {
     ecgroup::init_pairing();
 }
 
+const char* bbs04_curve_name() {
+    return ecgroup::Curve::NAME;
+}
+
 int bbs04_setup_c(
     unsigned char** gpk_out, size_t* gpk_len_out,
     unsigned char** osk_out, size_t* osk_len_out,
@@ -42,11 +67,8 @@ int bbs04_user_keygen_c(
     unsigned char** usk_out, size_t* usk_len_out)
 {
     try {
-        ecgroup::Bytes gpk_bytes(gpk_in, gpk_in + gpk_len_in);
-        ecgroup::Bytes isk_bytes(isk_in, isk_in + isk_len_in);
-    
-        bbsgs::GroupPublicKey  gpk = bbsgs::GroupPublicKey::from_bytes(gpk_bytes);
-        bbsgs::IssuerSecretKey isk = bbsgs::IssuerSecretKey::from_bytes(isk_bytes);
+        bbsgs::GroupPublicKey  gpk = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        bbsgs::IssuerSecretKey isk = bbsgs::IssuerSecretKey::read_from(isk_in, isk_len_in);
     
         bbsgs::UserSecretKey usk = bbsgs::bbs04_user_keygen(isk, gpk);
         copy_to_c_buf(usk.to_bytes(), usk_out, usk_len_out);
@@ -64,14 +86,10 @@ int bbs04_sign_c(
     unsigned char** sig_out, size_t* sig_len_out)
 {
     try {
-        ecgroup::Bytes gpk_bytes(gpk_in, gpk_in + gpk_len_in);
-        ecgroup::Bytes usk_bytes(usk_in, usk_in + usk_len_in);
-        ecgroup::Bytes msg_bytes(msg_in, msg_in + msg_len_in);
-    
-        bbsgs::GroupPublicKey  gpk = bbsgs::GroupPublicKey::from_bytes(gpk_bytes);
-        bbsgs::UserSecretKey   usk = bbsgs::UserSecretKey::from_bytes(usk_bytes);
+        bbsgs::GroupPublicKey  gpk = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        bbsgs::UserSecretKey   usk = bbsgs::UserSecretKey::read_from(usk_in, usk_len_in);
     
-        bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk, usk, msg_bytes);
+        bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk, usk, msg_in, msg_len_in);
         copy_to_c_buf(sigma.to_bytes(), sig_out, sig_len_out);
 
         return BBSGS_OK;
@@ -84,13 +102,15 @@ int bbs04_verify_usk_c(
     const unsigned char* gpk_in, size_t gpk_len_in,
     const unsigned char* usk_in, size_t usk_len_in)
 {
-    ecgroup::Bytes gpk_bytes(gpk_in, gpk_in + gpk_len_in);
-    ecgroup::Bytes usk_bytes(usk_in, usk_in + usk_len_in);
-
-    bbsgs::GroupPublicKey gpk = bbsgs::GroupPublicKey::from_bytes(gpk_bytes);
-    bbsgs::UserSecretKey  usk = bbsgs::UserSecretKey::from_bytes(usk_bytes);
+    try {
+        bbsgs::GroupPublicKey gpk = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        bbsgs::UserSecretKey  usk = bbsgs::UserSecretKey::read_from(usk_in, usk_len_in);
 
-    return bbsgs::bbs04_verify_usk(gpk, usk) ? 1 : 0;
+        return bbsgs::bbs04_verify_usk(gpk, usk) ? 1 : 0;
+    } catch(...) {
+        // Unparsable input is simply not valid; BBSGS_ERR would read as true in C
+        return 0;
+    }
 }
 
 int bbs04_verify_c(
@@ -98,14 +118,15 @@ int bbs04_verify_c(
     const unsigned char* sig_in, size_t sig_len_in,
     const unsigned char* msg_in, size_t msg_len_in)
 {
-    ecgroup::Bytes gpk_bytes(gpk_in, gpk_in + gpk_len_in);
-    ecgroup::Bytes sig_bytes(sig_in, sig_in + sig_len_in);
-    ecgroup::Bytes msg_bytes(msg_in, msg_in + msg_len_in);
-
-    bbsgs::GroupPublicKey  gpk   = bbsgs::GroupPublicKey::from_bytes(gpk_bytes);
-    bbsgs::GroupSignature  sigma = bbsgs::GroupSignature::from_bytes(sig_bytes);
+    try {
+        bbsgs::GroupPublicKey  gpk   = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        bbsgs::GroupSignature  sigma = bbsgs::GroupSignature::read_from(sig_in, sig_len_in);
 
-    return bbsgs::bbs04_verify(gpk, msg_bytes, sigma) ? 1 : 0;
+        return bbsgs::bbs04_verify(gpk, msg_in, msg_len_in, sigma) ? 1 : 0;
+    } catch(...) {
+        // Unparsable input is simply not valid; BBSGS_ERR would read as true in C
+        return 0;
+    }
 }
 
 int bbs04_open_c(
@@ -115,13 +136,9 @@ int bbs04_open_c(
     unsigned char** credential_A_out, size_t* credential_A_len_out)
 {
     try {
-        ecgroup::Bytes gpk_bytes(gpk_in,  gpk_in  + gpk_len_in);
-        ecgroup::Bytes osk_bytes(osk_in,  osk_in  + osk_len_in);
-        ecgroup::Bytes sig_bytes(sig_in,  sig_in  + sig_len_in);
-    
-        bbsgs::GroupPublicKey  gpk   = bbsgs::GroupPublicKey::from_bytes(gpk_bytes);
-        bbsgs::OpenerSecretKey osk   = bbsgs::OpenerSecretKey::from_bytes(osk_bytes);
-        bbsgs::GroupSignature  sigma = bbsgs::GroupSignature::from_bytes(sig_bytes);
+        bbsgs::GroupPublicKey  gpk   = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        bbsgs::OpenerSecretKey osk   = bbsgs::OpenerSecretKey::read_from(osk_in, osk_len_in);
+        bbsgs::GroupSignature  sigma = bbsgs::GroupSignature::read_from(sig_in, sig_len_in);
     
         ecgroup::G1Point opened_A = bbsgs::bbs04_open(gpk, osk, sigma);
         copy_to_c_buf(opened_A.to_bytes(), credential_A_out, credential_A_len_out);
@@ -132,6 +149,327 @@ int bbs04_open_c(
     }
 }
 
+// ------------------------------------------------------------------------
+// Pre-parsed key handles
+// ------------------------------------------------------------------------
+
+struct bbs04_gpk_handle {
+    bbsgs::PreparedGroupPublicKey pgpk;
+};
+
+struct bbs04_usk_handle {
+    bbsgs::PreparedUserSigningKey pusk;
+};
+
+struct bbs04_osk_handle {
+    bbsgs::OpenerSecretKey osk;
+};
+
+bbs04_gpk_handle* bbs04_gpk_handle_new(const unsigned char* gpk_in, size_t gpk_len_in) {
+    try {
+        bbsgs::GroupPublicKey gpk = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        return new bbs04_gpk_handle{bbsgs::PreparedGroupPublicKey(gpk)};
+    } catch(...) {
+        return nullptr;
+    }
+}
+
+bbs04_usk_handle* bbs04_usk_handle_new(
+    const bbs04_gpk_handle* gpk,
+    const unsigned char* usk_in, size_t usk_len_in)
+{
+    if (gpk == nullptr) return nullptr;
+    try {
+        bbsgs::UserSecretKey usk = bbsgs::UserSecretKey::read_from(usk_in, usk_len_in);
+        return new bbs04_usk_handle{bbsgs::PreparedUserSigningKey(usk, gpk->pgpk.gpk)};
+    } catch(...) {
+        return nullptr;
+    }
+}
+
+bbs04_osk_handle* bbs04_osk_handle_new(const unsigned char* osk_in, size_t osk_len_in) {
+    try {
+        return new bbs04_osk_handle{bbsgs::OpenerSecretKey::read_from(osk_in, osk_len_in)};
+    } catch(...) {
+        return nullptr;
+    }
+}
+
+void bbs04_gpk_handle_free(bbs04_gpk_handle* gpk) {
+    delete gpk;
+}
+
+void bbs04_usk_handle_free(bbs04_usk_handle* usk) {
+    delete usk;
+}
+
+void bbs04_osk_handle_free(bbs04_osk_handle* osk) {
+    delete osk;
+}
+
+int bbs04_sign_h(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_usk_handle* usk,
+    const unsigned char* msg_in, size_t msg_len_in,
+    unsigned char** sig_out, size_t* sig_len_out)
+{
+    if (gpk == nullptr || usk == nullptr) return BBSGS_ERR;
+    try {
+        bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk->pgpk, usk->pusk, msg_in, msg_len_in);
+        copy_to_c_buf(sigma.to_bytes(), sig_out, sig_len_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_verify_h(
+    const bbs04_gpk_handle* gpk,
+    const unsigned char* sig_in, size_t sig_len_in,
+    const unsigned char* msg_in, size_t msg_len_in)
+{
+    if (gpk == nullptr) return 0;
+    try {
+        bbsgs::GroupSignature sigma = bbsgs::GroupSignature::read_from(sig_in, sig_len_in);
+        return bbsgs::bbs04_verify(gpk->pgpk, msg_in, msg_len_in, sigma) ? 1 : 0;
+    } catch(...) {
+        return 0;
+    }
+}
+
+int bbs04_open_h(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_osk_handle* osk,
+    const unsigned char* sig_in, size_t sig_len_in,
+    unsigned char** credential_A_out, size_t* credential_A_len_out)
+{
+    if (gpk == nullptr || osk == nullptr) return BBSGS_ERR;
+    try {
+        bbsgs::GroupSignature sigma = bbsgs::GroupSignature::read_from(sig_in, sig_len_in);
+
+        ecgroup::G1Point opened_A = bbsgs::bbs04_open(gpk->pgpk.gpk, osk->osk, sigma);
+        copy_to_c_buf(opened_A.to_bytes(), credential_A_out, credential_A_len_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+// ------------------------------------------------------------------------
+// Batched calls
+// ------------------------------------------------------------------------
+
+int bbs04_verify_batch_h(
+    const bbs04_gpk_handle* gpk,
+    size_t count,
+    const unsigned char* sigs_in, const size_t* sig_lens_in,
+    const unsigned char* msgs_in, const size_t* msg_lens_in,
+    unsigned char* results_out)
+{
+    if (gpk == nullptr) return BBSGS_ERR;
+    if (count == 0) return 1;
+    if (sig_lens_in == nullptr || msg_lens_in == nullptr || results_out == nullptr) return BBSGS_ERR;
+    try {
+        // Each item is decoded and checked in place; an unparsable signature is
+        // simply invalid and does not fail the rest of the batch
+        bool all_valid = true;
+        for (size_t i = 0; i < count; ++i) {
+            bool ok = false;
+            try {
+                bbsgs::GroupSignature sigma = bbsgs::GroupSignature::read_from(sigs_in, sig_lens_in[i]);
+                ok = bbsgs::bbs04_verify(gpk->pgpk, msgs_in, msg_lens_in[i], sigma);
+            } catch (const std::invalid_argument&) {
+            } catch (const std::out_of_range&) {
+            }
+            results_out[i] = ok ? 1 : 0;
+            all_valid = all_valid && ok;
+            sigs_in += sig_lens_in[i];
+            msgs_in += msg_lens_in[i];
+        }
+        return all_valid ? 1 : 0;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_sign_batch_h(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_usk_handle* usk,
+    size_t count,
+    const unsigned char* msgs_in, const size_t* msg_lens_in,
+    unsigned char* sigs_out, size_t sigs_cap)
+{
+    if (gpk == nullptr || usk == nullptr) return BBSGS_ERR;
+    if (count == 0) return BBSGS_OK;
+    if (msg_lens_in == nullptr || sigs_cap / BBS04_SIGNATURE_SIZE < count) return BBSGS_ERR;
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            bbsgs::bbs04_sign(gpk->pgpk, usk->pusk, msgs_in, msg_lens_in[i]).write_to(sigs_out + i * BBS04_SIGNATURE_SIZE);
+            msgs_in += msg_lens_in[i];
+        }
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_user_keygen_batch(
+    const bbs04_gpk_handle* gpk,
+    const unsigned char* isk_in, size_t isk_len_in,
+    size_t count, size_t num_threads,
+    bbs04_usk_sink sink, void* ctx)
+{
+    if (gpk == nullptr || isk_in == nullptr || sink == nullptr) return BBSGS_ERR;
+    try {
+        bbsgs::IssuerSecretKey isk = bbsgs::IssuerSecretKey::read_from(isk_in, isk_len_in);
+        bool stopped = false;
+        bbsgs::bbs04_user_keygen_batch(isk, gpk->pgpk, count, [&](size_t index, const bbsgs::UserSecretKey& usk) {
+            unsigned char out[BBS04_USK_SIZE];
+            usk.write_to(out);
+            stopped = sink(ctx, index, out, sizeof(out)) != 0;
+            return !stopped;
+        }, num_threads);
+        return stopped ? BBSGS_STOPPED : BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+// ------------------------------------------------------------------------
+// Caller-provided output buffers
+// ------------------------------------------------------------------------
+
+int bbs04_setup_into(
+    unsigned char* gpk_out, size_t gpk_cap,
+    unsigned char* osk_out, size_t osk_cap,
+    unsigned char* isk_out, size_t isk_cap)
+{
+    if (gpk_cap < BBS04_GPK_SIZE || osk_cap < BBS04_OSK_SIZE || isk_cap < BBS04_ISK_SIZE) return BBSGS_ERR;
+    try {
+        bbsgs::GroupPublicKey gpk;
+        bbsgs::OpenerSecretKey osk;
+        bbsgs::IssuerSecretKey isk;
+        bbsgs::bbs04_setup(gpk, osk, isk);
+
+        gpk.write_to(gpk_out);
+        osk.write_to(osk_out);
+        isk.write_to(isk_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_user_keygen_into(
+    const unsigned char* gpk_in, size_t gpk_len_in,
+    const unsigned char* isk_in, size_t isk_len_in,
+    unsigned char* usk_out, size_t usk_cap)
+{
+    if (usk_cap < BBS04_USK_SIZE) return BBSGS_ERR;
+    try {
+        bbsgs::GroupPublicKey  gpk = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        bbsgs::IssuerSecretKey isk = bbsgs::IssuerSecretKey::read_from(isk_in, isk_len_in);
+
+        bbsgs::bbs04_user_keygen(isk, gpk).write_to(usk_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_sign_into(
+    const unsigned char* gpk_in, size_t gpk_len_in,
+    const unsigned char* usk_in, size_t usk_len_in,
+    const unsigned char* msg_in, size_t msg_len_in,
+    unsigned char* sig_out, size_t sig_cap)
+{
+    if (sig_cap < BBS04_SIGNATURE_SIZE) return BBSGS_ERR;
+    try {
+        bbsgs::GroupPublicKey  gpk = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        bbsgs::UserSecretKey   usk = bbsgs::UserSecretKey::read_from(usk_in, usk_len_in);
+
+        bbsgs::bbs04_sign(gpk, usk, msg_in, msg_len_in).write_to(sig_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_open_into(
+    const unsigned char* gpk_in, size_t gpk_len_in,
+    const unsigned char* osk_in, size_t osk_len_in,
+    const unsigned char* sig_in, size_t sig_len_in,
+    unsigned char* credential_A_out, size_t credential_A_cap)
+{
+    if (credential_A_cap < BBS04_CREDENTIAL_SIZE) return BBSGS_ERR;
+    try {
+        bbsgs::GroupPublicKey  gpk   = bbsgs::GroupPublicKey::read_from(gpk_in, gpk_len_in);
+        bbsgs::OpenerSecretKey osk   = bbsgs::OpenerSecretKey::read_from(osk_in, osk_len_in);
+        bbsgs::GroupSignature  sigma = bbsgs::GroupSignature::read_from(sig_in, sig_len_in);
+
+        bbsgs::bbs04_open(gpk, osk, sigma).write_to(credential_A_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_sign_h_into(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_usk_handle* usk,
+    const unsigned char* msg_in, size_t msg_len_in,
+    unsigned char* sig_out, size_t sig_cap)
+{
+    if (gpk == nullptr || usk == nullptr || sig_cap < BBS04_SIGNATURE_SIZE) return BBSGS_ERR;
+    try {
+        bbsgs::bbs04_sign(gpk->pgpk, usk->pusk, msg_in, msg_len_in).write_to(sig_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_sign_h_into_v2(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_usk_handle* usk,
+    const unsigned char* msg_in, size_t msg_len_in,
+    unsigned char* sig_out, size_t sig_cap)
+{
+    if (gpk == nullptr || usk == nullptr || sig_cap < BBS04_SIGNATURE_V2_SIZE) return BBSGS_ERR;
+    try {
+        bbsgs::bbs04_sign(gpk->pgpk, usk->pusk, msg_in, msg_len_in, bbsgs::SignatureVersion::V2).write_to(sig_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
+int bbs04_open_h_into(
+    const bbs04_gpk_handle* gpk,
+    const bbs04_osk_handle* osk,
+    const unsigned char* sig_in, size_t sig_len_in,
+    unsigned char* credential_A_out, size_t credential_A_cap)
+{
+    if (gpk == nullptr || osk == nullptr || credential_A_cap < BBS04_CREDENTIAL_SIZE) return BBSGS_ERR;
+    try {
+        bbsgs::GroupSignature sigma = bbsgs::GroupSignature::read_from(sig_in, sig_len_in);
+
+        bbsgs::bbs04_open(gpk->pgpk.gpk, osk->osk, sigma).write_to(credential_A_out);
+
+        return BBSGS_OK;
+    } catch(...) {
+        return BBSGS_ERR;
+    }
+}
+
 // ------------------------------------------------------------------------
 // EC scalar & G1 helpers
 // ------------------------------------------------------------------------
@@ -153,7 +491,7 @@ int ec_scalar_inverse(
     unsigned char** scalar_inv_out, size_t* scalar_inv_len_out)
 {
     try {
-        ecgroup::Scalar s = ecgroup::Scalar::from_bytes(ecgroup::Bytes(scalar_in, scalar_in + scalar_len_in));
+        ecgroup::Scalar s = ecgroup::Scalar::read_from(scalar_in, scalar_len_in);
         ecgroup::Bytes inv = s.inverse().to_bytes();
         copy_to_c_buf(inv, scalar_inv_out, scalar_inv_len_out);
         return BBSGS_OK;
@@ -183,8 +521,8 @@ int ec_g1_mul(
     unsigned char** point_out, size_t* point_len_out)
 {
     try {
-        ecgroup::Scalar scalar = ecgroup::Scalar::from_bytes(ecgroup::Bytes(scalar_in, scalar_in + scalar_len_in));
-        ecgroup::G1Point point = ecgroup::G1Point::from_bytes(ecgroup::Bytes(point_in, point_in + point_len_in));
+        ecgroup::Scalar scalar = ecgroup::Scalar::read_from(scalar_in, scalar_len_in);
+        ecgroup::G1Point point = ecgroup::G1Point::read_from(point_in, point_len_in);
         ecgroup::G1Point res = ecgroup::G1Point::mul(point, scalar);
         copy_to_c_buf(res.to_bytes(), point_out, point_len_out);
 
@@ -194,6 +532,36 @@ int ec_g1_mul(
     }
 }
 
+int bbs04_metrics_set_enabled(int enabled) {
+    if (enabled && !ecgroup::metrics::COMPILED_IN) return BBSGS_ERR;
+    ecgroup::metrics::set_enabled(enabled != 0);
+    return BBSGS_OK;
+}
+
+int bbs04_metrics_snapshot(bbs04_metrics* out) {
+    if (out == nullptr) return BBSGS_ERR;
+    ecgroup::metrics::Snapshot s = ecgroup::metrics::snapshot();
+    std::copy(std::begin(s.counters), std::end(s.counters), out->counters);
+    std::copy(std::begin(s.op_count), std::end(s.op_count), out->op_count);
+    std::copy(std::begin(s.op_latency_sum_ns), std::end(s.op_latency_sum_ns), out->op_latency_sum_ns);
+    for (size_t op = 0; op < BBS04_OPS; ++op) {
+        std::copy(std::begin(s.op_latency_buckets[op]), std::end(s.op_latency_buckets[op]), out->op_latency_buckets[op]);
+    }
+    return BBSGS_OK;
+}
+
+void bbs04_metrics_reset(void) {
+    ecgroup::metrics::reset();
+}
+
+void bbs04_random_set_seed(uint64_t seed) {
+    ecgroup::set_random_seed(seed);
+}
+
+void bbs04_random_clear_seed(void) {
+    ecgroup::clear_random_seed();
+}
+
 void free_byte_buffer(unsigned char* buf) {
     delete[] buf;
 }
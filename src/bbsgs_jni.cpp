@@ -1,12 +1,70 @@
 #include <jni.h>
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
 #include "bbsgs/bbsgs_c.h"
 
+// Classes and method IDs resolved once in JNI_OnLoad. FindClass is only
+// reliable there on Android (native threads see the system class loader), and
+// it is far too slow to repeat on every call.
+static jclass    g_runtimeException         = nullptr;
+static jclass    g_illegalArgumentException = nullptr;
+static jclass    g_setupResult              = nullptr;
+static jmethodID g_setupResultCtor          = nullptr;
+static jmethodID g_bufferPosition           = nullptr;
+static jmethodID g_bufferLimit              = nullptr;
+
+static jclass globalClass(JNIEnv* env, const char* name) {
+    jclass local = env->FindClass(name);
+    if (!local) return nullptr;
+    jclass global = static_cast<jclass>(env->NewGlobalRef(local));
+    env->DeleteLocalRef(local);
+    return global;
+}
+
 // Helper: throw a Java RuntimeException with the given message
 static void throwJavaException(JNIEnv* env, const char* msg) {
-    jclass exClass = env->FindClass("java/lang/RuntimeException");
-    if (exClass) env->ThrowNew(exClass, msg);
+    env->ThrowNew(g_runtimeException, msg);
+}
+
+static void throwIllegalArgument(JNIEnv* env, const char* msg) {
+    env->ThrowNew(g_illegalArgumentException, msg);
+}
+
+// Handles cross into Kotlin as Long; go through intptr_t so 32-bit ABIs work.
+template <typename T>
+static jlong toJavaHandle(T* p) {
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(p));
+}
+
+template <typename T>
+static T* fromJavaHandle(JNIEnv* env, jlong h) {
+    if (h == 0) {
+        throwIllegalArgument(env, "null handle");
+        return nullptr;
+    }
+    return reinterpret_cast<T*>(static_cast<intptr_t>(h));
+}
+
+// View of the remaining bytes [position, limit) of a direct ByteBuffer. No
+// copy is made; the buffer must stay reachable for the duration of the call.
+struct DirectBytes {
+    unsigned char* data = nullptr;
+    size_t len = 0;
+};
+
+static bool directBytes(JNIEnv* env, jobject buf, DirectBytes& out) {
+    auto* base = static_cast<unsigned char*>(buf ? env->GetDirectBufferAddress(buf) : nullptr);
+    if (!base) {
+        throwIllegalArgument(env, "expected a direct ByteBuffer");
+        return false;
+    }
+    jint pos = env->CallIntMethod(buf, g_bufferPosition);
+    jint lim = env->CallIntMethod(buf, g_bufferLimit);
+    if (env->ExceptionCheck()) return false;
+    out.data = base + pos;
+    out.len = static_cast<size_t>(lim - pos);
+    return true;
 }
 
 // Helper: copy native buffer → new Java byte[]
@@ -21,12 +79,46 @@ static jbyteArray toJavaByteArray(JNIEnv* env,
 
 extern "C" {
 
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) return JNI_ERR;
+
+    g_runtimeException         = globalClass(env, "java/lang/RuntimeException");
+    g_illegalArgumentException = globalClass(env, "java/lang/IllegalArgumentException");
+    g_setupResult              = globalClass(env, "io/github/denseidentity/bbsgroupsig/BBSGS$SetupResult");
+    if (!g_runtimeException || !g_illegalArgumentException || !g_setupResult) return JNI_ERR;
+
+    g_setupResultCtor = env->GetMethodID(g_setupResult, "<init>", "([B[B[B)V");
+    jclass buffer = env->FindClass("java/nio/Buffer");
+    if (!g_setupResultCtor || !buffer) return JNI_ERR;
+    g_bufferPosition = env->GetMethodID(buffer, "position", "()I");
+    g_bufferLimit    = env->GetMethodID(buffer, "limit", "()I");
+    env->DeleteLocalRef(buffer);
+    if (!g_bufferPosition || !g_bufferLimit) return JNI_ERR;
+
+    return JNI_VERSION_1_6;
+}
+
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM* vm, void*) {
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) return;
+    env->DeleteGlobalRef(g_runtimeException);
+    env->DeleteGlobalRef(g_illegalArgumentException);
+    env->DeleteGlobalRef(g_setupResult);
+}
+
 // Kotlin: external fun bbs04InitPairing()
 JNIEXPORT void JNICALL
 Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04InitPairing(JNIEnv* env, jclass) {
     bbs04_init_pairing();
 }
 
+// Kotlin: external fun bbs04CurveName(): String
+JNIEXPORT jstring JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04CurveName(JNIEnv* env, jclass) {
+    return env->NewStringUTF(bbs04_curve_name());
+}
+
 // Kotlin: external fun bbs04Setup(): SetupResult
 JNIEXPORT jobject JNICALL
 Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04Setup(JNIEnv* env, jclass) {
@@ -42,9 +134,7 @@ Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04Setup(JNIEnv* env, jclass) {
     jbyteArray josk = toJavaByteArray(env, osk, osk_len);
     jbyteArray jisk = toJavaByteArray(env, isk, isk_len);
 
-    jclass cls = env->FindClass("io/github/denseidentity/bbsgroupsig/BBSGS$SetupResult");
-    jmethodID ctor = env->GetMethodID(cls, "<init>", "([B[B[B)V");
-    return env->NewObject(cls, ctor, jgpk, josk, jisk);
+    return env->NewObject(g_setupResult, g_setupResultCtor, jgpk, josk, jisk);
 }
 
 // Kotlin: external fun bbs04UserKeygen(gpk: ByteArray, isk: ByteArray): ByteArray
@@ -241,4 +331,321 @@ Java_io_github_denseidentity_bbsgroupsig_BBSGS_ecG1Mul(JNIEnv* env, jclass,
     return toJavaByteArray(env, out, out_len);
 }
 
-} // extern "C"
\ No newline at end of file
+// ------------------------------------------------------------------------
+// Prepared key handles
+// ------------------------------------------------------------------------
+//
+// A handle is a native pointer held as a Long on the Kotlin side. Each *New
+// must be paired with the matching *Free; handles are safe to share between
+// threads.
+
+// Kotlin: external fun bbs04GpkHandleNew(gpk: ByteArray): Long
+JNIEXPORT jlong JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04GpkHandleNew(JNIEnv* env, jclass,
+                                                                 jbyteArray jgpk) {
+    jsize gpk_len = env->GetArrayLength(jgpk);
+    std::vector<unsigned char> gpk_buf(gpk_len);
+    env->GetByteArrayRegion(jgpk, 0, gpk_len, reinterpret_cast<jbyte*>(gpk_buf.data()));
+
+    bbs04_gpk_handle* gpk = bbs04_gpk_handle_new(gpk_buf.data(), gpk_len);
+    if (!gpk) {
+        throwJavaException(env, "bbs04_gpk_handle_new failed");
+        return 0;
+    }
+    return toJavaHandle(gpk);
+}
+
+// Kotlin: external fun bbs04GpkHandleFree(gpk: Long)
+JNIEXPORT void JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04GpkHandleFree(JNIEnv*, jclass, jlong h) {
+    bbs04_gpk_handle_free(reinterpret_cast<bbs04_gpk_handle*>(static_cast<intptr_t>(h)));
+}
+
+// Kotlin: external fun bbs04UskHandleNew(gpk: Long, usk: ByteArray): Long
+JNIEXPORT jlong JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04UskHandleNew(JNIEnv* env, jclass,
+                                                                 jlong jgpk,
+                                                                 jbyteArray jusk) {
+    auto* gpk = fromJavaHandle<bbs04_gpk_handle>(env, jgpk);
+    if (!gpk) return 0;
+
+    jsize usk_len = env->GetArrayLength(jusk);
+    std::vector<unsigned char> usk_buf(usk_len);
+    env->GetByteArrayRegion(jusk, 0, usk_len, reinterpret_cast<jbyte*>(usk_buf.data()));
+
+    bbs04_usk_handle* usk = bbs04_usk_handle_new(gpk, usk_buf.data(), usk_len);
+    if (!usk) {
+        throwJavaException(env, "bbs04_usk_handle_new failed");
+        return 0;
+    }
+    return toJavaHandle(usk);
+}
+
+// Kotlin: external fun bbs04UskHandleFree(usk: Long)
+JNIEXPORT void JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04UskHandleFree(JNIEnv*, jclass, jlong h) {
+    bbs04_usk_handle_free(reinterpret_cast<bbs04_usk_handle*>(static_cast<intptr_t>(h)));
+}
+
+// Kotlin: external fun bbs04OskHandleNew(osk: ByteArray): Long
+JNIEXPORT jlong JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04OskHandleNew(JNIEnv* env, jclass,
+                                                                 jbyteArray josk) {
+    jsize osk_len = env->GetArrayLength(josk);
+    std::vector<unsigned char> osk_buf(osk_len);
+    env->GetByteArrayRegion(josk, 0, osk_len, reinterpret_cast<jbyte*>(osk_buf.data()));
+
+    bbs04_osk_handle* osk = bbs04_osk_handle_new(osk_buf.data(), osk_len);
+    if (!osk) {
+        throwJavaException(env, "bbs04_osk_handle_new failed");
+        return 0;
+    }
+    return toJavaHandle(osk);
+}
+
+// Kotlin: external fun bbs04OskHandleFree(osk: Long)
+JNIEXPORT void JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04OskHandleFree(JNIEnv*, jclass, jlong h) {
+    bbs04_osk_handle_free(reinterpret_cast<bbs04_osk_handle*>(static_cast<intptr_t>(h)));
+}
+
+// ------------------------------------------------------------------------
+// Direct ByteBuffer variants
+// ------------------------------------------------------------------------
+//
+// Inputs are read in place from the remaining bytes of direct ByteBuffers and
+// outputs are written in place, so no Java heap copy is made. Buffer positions
+// are left untouched. Heap (non-direct) buffers are rejected with
+// IllegalArgumentException.
+
+// Kotlin: external fun bbs04SignDirect(gpk: Long, usk: Long, msg: ByteBuffer, sigOut: ByteBuffer): Int
+// Writes the signature at sigOut's position and returns its length.
+JNIEXPORT jint JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04SignDirect(JNIEnv* env, jclass,
+                                                               jlong jgpk,
+                                                               jlong jusk,
+                                                               jobject jmsg,
+                                                               jobject jsig) {
+    auto* gpk = fromJavaHandle<bbs04_gpk_handle>(env, jgpk);
+    if (!gpk) return 0;
+    auto* usk = fromJavaHandle<bbs04_usk_handle>(env, jusk);
+    if (!usk) return 0;
+
+    DirectBytes msg, sig;
+    if (!directBytes(env, jmsg, msg) || !directBytes(env, jsig, sig)) return 0;
+
+    if (bbs04_sign_h_into(gpk, usk, msg.data, msg.len, sig.data, sig.len) != BBSGS_OK) {
+        throwJavaException(env, "bbs04_sign_h_into failed");
+        return 0;
+    }
+    return BBS04_SIGNATURE_SIZE;
+}
+
+// Kotlin: external fun bbs04VerifyDirect(gpk: Long, sig: ByteBuffer, msg: ByteBuffer): Boolean
+JNIEXPORT jboolean JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04VerifyDirect(JNIEnv* env, jclass,
+                                                                 jlong jgpk,
+                                                                 jobject jsig,
+                                                                 jobject jmsg) {
+    auto* gpk = fromJavaHandle<bbs04_gpk_handle>(env, jgpk);
+    if (!gpk) return JNI_FALSE;
+
+    DirectBytes sig, msg;
+    if (!directBytes(env, jsig, sig) || !directBytes(env, jmsg, msg)) return JNI_FALSE;
+
+    int ok = bbs04_verify_h(gpk, sig.data, sig.len, msg.data, msg.len);
+    return (ok == 1) ? JNI_TRUE : JNI_FALSE;
+}
+
+// Kotlin: external fun bbs04OpenDirect(gpk: Long, osk: Long, sig: ByteBuffer, credOut: ByteBuffer): Int
+// Writes the credential at credOut's position and returns its length.
+JNIEXPORT jint JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04OpenDirect(JNIEnv* env, jclass,
+                                                               jlong jgpk,
+                                                               jlong josk,
+                                                               jobject jsig,
+                                                               jobject jcred) {
+    auto* gpk = fromJavaHandle<bbs04_gpk_handle>(env, jgpk);
+    if (!gpk) return 0;
+    auto* osk = fromJavaHandle<bbs04_osk_handle>(env, josk);
+    if (!osk) return 0;
+
+    DirectBytes sig, cred;
+    if (!directBytes(env, jsig, sig) || !directBytes(env, jcred, cred)) return 0;
+
+    if (bbs04_open_h_into(gpk, osk, sig.data, sig.len, cred.data, cred.len) != BBSGS_OK) {
+        throwJavaException(env, "bbs04_open_h_into failed");
+        return 0;
+    }
+    return BBS04_CREDENTIAL_SIZE;
+}
+
+// ------------------------------------------------------------------------
+// Batched calls
+// ------------------------------------------------------------------------
+
+// Kotlin: external fun bbs04VerifyBatch(gpk: Long, sigs: Array<ByteArray>, msgs: Array<ByteArray>): BooleanArray
+// One JNI transition for the whole batch. Element i of the result is true iff
+// sigs[i] is a valid signature on msgs[i]. Every array is copied once; use
+// bbs04VerifyBatchDirect to verify from direct buffers without copies.
+JNIEXPORT jbooleanArray JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04VerifyBatch(JNIEnv* env, jclass,
+                                                                jlong jgpk,
+                                                                jobjectArray jsigs,
+                                                                jobjectArray jmsgs) {
+    auto* gpk = fromJavaHandle<bbs04_gpk_handle>(env, jgpk);
+    if (!gpk) return nullptr;
+
+    jsize count = env->GetArrayLength(jsigs);
+    if (env->GetArrayLength(jmsgs) != count) {
+        throwIllegalArgument(env, "sigs and msgs differ in length");
+        return nullptr;
+    }
+
+    // Pack both sides back to back, as bbs04_verify_batch_h expects.
+    std::vector<size_t> sig_lens(count), msg_lens(count);
+    std::vector<unsigned char> sigs, msgs;
+    sigs.reserve(static_cast<size_t>(count) * BBS04_SIGNATURE_SIZE);
+    for (jsize i = 0; i < count; ++i) {
+        auto jsig = static_cast<jbyteArray>(env->GetObjectArrayElement(jsigs, i));
+        auto jmsg = static_cast<jbyteArray>(env->GetObjectArrayElement(jmsgs, i));
+        if (!jsig || !jmsg) {
+            throwIllegalArgument(env, "null element in batch");
+            return nullptr;
+        }
+
+        sig_lens[i] = env->GetArrayLength(jsig);
+        sigs.resize(sigs.size() + sig_lens[i]);
+        env->GetByteArrayRegion(jsig, 0, (jsize)sig_lens[i],
+                                reinterpret_cast<jbyte*>(sigs.data() + sigs.size() - sig_lens[i]));
+
+        msg_lens[i] = env->GetArrayLength(jmsg);
+        msgs.resize(msgs.size() + msg_lens[i]);
+        env->GetByteArrayRegion(jmsg, 0, (jsize)msg_lens[i],
+                                reinterpret_cast<jbyte*>(msgs.data() + msgs.size() - msg_lens[i]));
+
+        // Large batches would otherwise exhaust the local reference table.
+        env->DeleteLocalRef(jsig);
+        env->DeleteLocalRef(jmsg);
+    }
+
+    std::vector<unsigned char> results(count);
+    if (bbs04_verify_batch_h(gpk, count,
+                             sigs.data(), sig_lens.data(),
+                             msgs.data(), msg_lens.data(),
+                             results.data()) == BBSGS_ERR) {
+        throwJavaException(env, "bbs04_verify_batch_h failed");
+        return nullptr;
+    }
+
+    // jboolean is an unsigned char holding 0 or 1, the same as results_out.
+    jbooleanArray out = env->NewBooleanArray(count);
+    if (!out) return nullptr;
+    env->SetBooleanArrayRegion(out, 0, count, reinterpret_cast<const jboolean*>(results.data()));
+    return out;
+}
+
+// Kotlin: external fun bbs04VerifyBatchDirect(gpk: Long, sigs: ByteBuffer, sigLens: IntArray,
+//                                             msgs: ByteBuffer, msgLens: IntArray,
+//                                             resultsOut: ByteBuffer): Boolean
+// Zero-copy form of bbs04VerifyBatch over direct ByteBuffers packed as
+// bbs04_verify_batch_h expects: signatures and messages are read in place from
+// sigs and msgs, and one 0/1 byte per item is written at resultsOut's position.
+// Only the length arrays are copied. Returns true iff every signature is valid.
+JNIEXPORT jboolean JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04VerifyBatchDirect(JNIEnv* env, jclass,
+                                                                      jlong jgpk,
+                                                                      jobject jsigs,
+                                                                      jintArray jsig_lens,
+                                                                      jobject jmsgs,
+                                                                      jintArray jmsg_lens,
+                                                                      jobject jresults) {
+    auto* gpk = fromJavaHandle<bbs04_gpk_handle>(env, jgpk);
+    if (!gpk) return JNI_FALSE;
+
+    DirectBytes sigs, msgs, results;
+    if (!directBytes(env, jsigs, sigs) || !directBytes(env, jmsgs, msgs) ||
+        !directBytes(env, jresults, results)) {
+        return JNI_FALSE;
+    }
+    if (!jsig_lens || !jmsg_lens) {
+        throwIllegalArgument(env, "null length array");
+        return JNI_FALSE;
+    }
+    jsize count = env->GetArrayLength(jsig_lens);
+    if (env->GetArrayLength(jmsg_lens) != count) {
+        throwIllegalArgument(env, "sigLens and msgLens differ in length");
+        return JNI_FALSE;
+    }
+    if (results.len < static_cast<size_t>(count)) {
+        throwIllegalArgument(env, "resultsOut has fewer bytes remaining than items");
+        return JNI_FALSE;
+    }
+
+    // Widen the lengths to size_t and check that the packed items fit their buffers.
+    std::vector<jint> lens(static_cast<size_t>(count) * 2);
+    env->GetIntArrayRegion(jsig_lens, 0, count, lens.data());
+    env->GetIntArrayRegion(jmsg_lens, 0, count, lens.data() + count);
+    std::vector<size_t> sig_lens(count), msg_lens(count);
+    size_t sig_total = 0, msg_total = 0;
+    for (jsize i = 0; i < count; ++i) {
+        if (lens[i] < 0 || lens[count + i] < 0) {
+            throwIllegalArgument(env, "negative length in batch");
+            return JNI_FALSE;
+        }
+        sig_lens[i] = static_cast<size_t>(lens[i]);
+        msg_lens[i] = static_cast<size_t>(lens[count + i]);
+        sig_total += sig_lens[i];
+        msg_total += msg_lens[i];
+    }
+    if (sig_total > sigs.len || msg_total > msgs.len) {
+        throwIllegalArgument(env, "lengths exceed the remaining buffer bytes");
+        return JNI_FALSE;
+    }
+
+    int rc = bbs04_verify_batch_h(gpk, count,
+                                  sigs.data, sig_lens.data(),
+                                  msgs.data, msg_lens.data(),
+                                  results.data);
+    if (rc == BBSGS_ERR) {
+        throwJavaException(env, "bbs04_verify_batch_h failed");
+        return JNI_FALSE;
+    }
+    return (rc == 1) ? JNI_TRUE : JNI_FALSE;
+}
+
+// ------------------------------------------------------------------------
+// Metrics
+// ------------------------------------------------------------------------
+
+// Kotlin: external fun bbs04MetricsSetEnabled(enabled: Boolean): Boolean
+// Returns false when the library was built without metrics.
+JNIEXPORT jboolean JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04MetricsSetEnabled(JNIEnv*, jclass, jboolean enabled) {
+    return bbs04_metrics_set_enabled(enabled ? 1 : 0) == BBSGS_OK ? JNI_TRUE : JNI_FALSE;
+}
+
+// Kotlin: external fun bbs04MetricsSnapshot(): LongArray
+// The fields of bbs04_metrics in declaration order: BBS04_METRIC_COUNTERS
+// counters, BBS04_OPS call counts, BBS04_OPS latency sums, then
+// BBS04_OPS x BBS04_LATENCY_BUCKETS histogram buckets (row per op).
+JNIEXPORT jlongArray JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04MetricsSnapshot(JNIEnv* env, jclass) {
+    static_assert(sizeof(bbs04_metrics) % sizeof(jlong) == 0, "bbs04_metrics must be all 64-bit fields");
+    const jsize n = sizeof(bbs04_metrics) / sizeof(jlong);
+
+    bbs04_metrics m;
+    bbs04_metrics_snapshot(&m);
+    jlongArray out = env->NewLongArray(n);
+    if (!out) return nullptr;
+    env->SetLongArrayRegion(out, 0, n, reinterpret_cast<const jlong*>(&m));
+    return out;
+}
+
+// Kotlin: external fun bbs04MetricsReset()
+JNIEXPORT void JNICALL
+Java_io_github_denseidentity_bbsgroupsig_BBSGS_bbs04MetricsReset(JNIEnv*, jclass) {
+    bbs04_metrics_reset();
+}
+
+} // extern "C"
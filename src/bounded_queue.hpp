@@ -0,0 +1,119 @@
+#ifndef BBSGS_BOUNDED_QUEUE_HPP
+#define BBSGS_BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bbsgs {
+
+    /**
+     * Lock-free bounded multi-producer/multi-consumer queue (Vyukov's sequenced ring).
+     * Each slot carries a sequence number that tells producers and consumers whose turn
+     * it is, so push and pop are a single CAS on the shared cursor plus a slot handoff.
+     * Capacity is rounded up to a power of two.
+     *
+     * T must provide wipe(). A popped item is moved out and its cell wiped, and the
+     * destructor wipes whatever is still queued, so the ring never keeps a copy of
+     * secret material (presignature nonces) after handing it out.
+     */
+    template <class T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity)
+            : cells(round_up_pow2(capacity)), mask(cells.size() - 1), enqueue_pos(0), dequeue_pos(0) {
+            for (size_t i = 0; i < cells.size(); ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~BoundedQueue() {
+            for (Cell& cell : cells) {
+                cell.data.wipe();
+            }
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        // Returns false when the queue is full.
+        bool try_push(T&& item) {
+            Cell* cell;
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &cells[pos & mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->data = std::move(item);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Returns false when the queue is empty.
+        bool try_pop(T& out) {
+            Cell* cell;
+            size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &cells[pos & mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            out = std::move(cell->data);
+            cell->data.wipe();
+            cell->sequence.store(pos + mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Approximate number of queued items; exact when no push or pop is in flight.
+        size_t size() const {
+            size_t head = dequeue_pos.load(std::memory_order_relaxed);
+            size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+        size_t capacity() const { return cells.size(); }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        static size_t round_up_pow2(size_t n) {
+            size_t p = 1;
+            while (p < n) {
+                p <<= 1;
+            }
+            return p;
+        }
+
+        std::vector<Cell> cells;
+        const size_t mask;
+        // Keep the two cursors on separate cache lines so producers and consumers don't false-share
+        alignas(64) std::atomic<size_t> enqueue_pos;
+        alignas(64) std::atomic<size_t> dequeue_pos;
+    };
+
+} // namespace bbsgs
+
+#endif // BBSGS_BOUNDED_QUEUE_HPP
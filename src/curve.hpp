@@ -0,0 +1,47 @@
+#ifndef SHIM_CURVE_HPP
+#define SHIM_CURVE_HPP
+
+#include <bbsgs/config.h>
+#include <mcl/bn.hpp>
+#include <cstddef>
+
+namespace ecgroup {
+
+    /**
+     * Compile-time description of a supported pairing curve: the mcl parameters and
+     * the byte sizes of its canonical encodings. Everything that depends on the curve
+     * reads it from here, so switching curves changes constants, not code paths.
+     *
+     * mcl keeps the curve in process-wide state (the field moduli are static members
+     * of mcl::bn::Fp and Fr), so a build links exactly one curve. It is chosen with the
+     * CMake option BBSGS_CURVE; to compare curves, build once per curve (ctest and
+     * benchmarks/compare_curves.sh do this for the other curve).
+     */
+    struct Bn254 {
+        static constexpr const char* NAME = "BN254";
+        static constexpr size_t FP_SIZE = 32;
+        static constexpr size_t FR_SIZE = 32;
+        // Cofactor 1: every point on the curve is in the prime-order subgroup
+        static constexpr bool G1_PRIME_ORDER = true;
+        static const mcl::CurveParam& param() { return mcl::BN254; }
+    };
+
+    struct Bls12_381 {
+        static constexpr const char* NAME = "BLS12_381";
+        static constexpr size_t FP_SIZE = 48;
+        static constexpr size_t FR_SIZE = 32;
+        static constexpr bool G1_PRIME_ORDER = false;
+        static const mcl::CurveParam& param() { return mcl::BLS12_381; }
+    };
+
+#if defined(BBSGS_CURVE_BLS12_381)
+    using Curve = Bls12_381;
+#elif defined(BBSGS_CURVE_BN254)
+    using Curve = Bn254;
+#else
+#error "bbsgs/config.h does not name a supported curve"
+#endif
+
+} // namespace ecgroup
+
+#endif // SHIM_CURVE_HPP
@@ -1,15 +1,124 @@
 #include "ecgroup.hpp"
+#include "arena.hpp"
+#include "metrics.hpp"
+#include "random.hpp"
+#include <algorithm>
+#include <stdexcept>
 
 namespace ecgroup {
 
+    namespace {
+        using metrics::Counter;
+
+        // Canonical value of a scalar as little-endian 64-bit limbs.
+        constexpr size_t SCALAR_WORDS = 4;
+
+        void scalar_to_words(const Scalar& s, uint64_t (&words)[SCALAR_WORDS]) {
+            bool ok = false;
+            s.get_underlying().getArray(&ok, words, SCALAR_WORDS);
+            if (!ok) {
+                throw std::runtime_error("Scalar does not fit in the fixed-base window buffer.");
+            }
+        }
+
+        // Bits [pos, pos + width) of a little-endian limb array.
+        size_t window_digit(const uint64_t (&words)[SCALAR_WORDS], size_t pos, size_t width) {
+            size_t word = pos / 64;
+            size_t shift = pos % 64;
+            if (word >= SCALAR_WORDS) {
+                return 0;
+            }
+            uint64_t bits = words[word] >> shift;
+            if (shift + width > 64 && word + 1 < SCALAR_WORDS) {
+                bits |= words[word + 1] << (64 - shift);
+            }
+            return static_cast<size_t>(bits & ((uint64_t(1) << width) - 1));
+        }
+
+        // Uniform scalar by rejection sampling: keep the low bit-length bits of the
+        // random words and fail if the result is not below the group order.
+        bool set_masked(mcl::bn::Fr& v, uint64_t (&words)[SCALAR_WORDS]) {
+            const size_t bits = mcl::bn::Fr::getBitSize();
+            for (size_t i = 0; i < SCALAR_WORDS; ++i) {
+                if (64 * i >= bits) {
+                    words[i] = 0;
+                } else if (64 * (i + 1) > bits) {
+                    words[i] &= (uint64_t(1) << (bits % 64)) - 1;
+                }
+            }
+            bool ok = false;
+            v.setArray(&ok, words, SCALAR_WORDS);
+            return ok;
+        }
+
+        void set_one(mcl::bn::Fp& z) {
+            z = 1;
+        }
+
+        void set_one(mcl::bn::Fp2& z) {
+            z.a = 1;
+            z.b = 0;
+        }
+
+        // Affine x || y, each coordinate coord_size bytes (the compressed size of the
+        // group). The identity has no affine form and is written as all zeros, which
+        // is not a curve point since b != 0.
+        template <class Ec>
+        void write_affine(const Ec& p, uint8_t* out, size_t coord_size) {
+            if (p.isZero()) {
+                std::fill(out, out + 2 * coord_size, 0);
+                return;
+            }
+            Ec affine(p);
+            affine.normalize();
+            affine.x.serialize(out, coord_size);
+            affine.y.serialize(out + coord_size, coord_size);
+        }
+
+        template <class Ec>
+        void read_affine(Ec& p, const uint8_t* in, size_t coord_size) {
+            if (std::all_of(in, in + 2 * coord_size, [](uint8_t b) { return b == 0; })) {
+                p.clear();
+                return;
+            }
+            if (p.x.deserialize(in, coord_size) != coord_size ||
+                p.y.deserialize(in + coord_size, coord_size) != coord_size) {
+                metrics::count(Counter::DecodeFailures);
+                throw std::invalid_argument("Affine coordinate out of range.");
+            }
+            set_one(p.z);
+        }
+
+        // prime_order: every point on the curve is in the subgroup (cofactor 1), so Full
+        // needs no subgroup test beyond the curve check
+        template <class Ec>
+        void validate_point(const Ec& p, PointEncoding encoding, Validation validation, bool prime_order) {
+            if (validation == Validation::Trusted || p.isZero()) {
+                return;
+            }
+            // mcl only ever derives compressed points from the curve equation
+            if (encoding == PointEncoding::Uncompressed && !p.isValid()) {
+                metrics::count(Counter::DecodeFailures);
+                throw std::invalid_argument("Point is not on the curve.");
+            }
+            if (validation == Validation::Full && !prime_order && !p.isValidOrder()) {
+                metrics::count(Counter::DecodeFailures);
+                throw std::invalid_argument("Point is not in the prime-order subgroup.");
+            }
+        }
+    } // namespace
+
     void init_pairing() {
-        mcl::bn::initPairing();
+        mcl::bn::initPairing(Curve::param());
+        // Subgroup checks are done explicitly by read_from according to its Validation
+        mcl::bn::verifyOrderG1(false);
+        mcl::bn::verifyOrderG2(false);
     }
 
     // --- Scalar Implementation ---
     Scalar::Scalar() {}
     
-    void Scalar::set_random() { value.setRand(); }
+    void Scalar::set_random() { fill_random(this, 1); }
 
     Scalar Scalar::get_random() {
         Scalar s;
@@ -17,12 +126,54 @@ namespace ecgroup {
         return s;
     }
 
+    void Scalar::fill_random(Scalar* out, size_t n) {
+        constexpr size_t CHUNK = 8;
+        uint64_t words[CHUNK][SCALAR_WORDS];
+        for (size_t i = 0; i < n; i += CHUNK) {
+            size_t m = std::min(CHUNK, n - i);
+            random_bytes(reinterpret_cast<uint8_t*>(words), m * sizeof(words[0]));
+            for (size_t j = 0; j < m; ++j) {
+                while (!set_masked(out[i + j].value, words[j])) {
+                    random_bytes(reinterpret_cast<uint8_t*>(words[j]), sizeof(words[j]));
+                }
+            }
+        }
+        secure_wipe(words, sizeof(words));
+    }
+
     Scalar Scalar::inverse() const {
         Scalar inv;
         mcl::bn::Fr::inv(inv.value, this->value);
         return inv;
     }
 
+    void Scalar::batch_inverse(Scalar* values, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        // prefix[i] = values[0] * ... * values[i]
+        ScratchArena::Scope scope;
+        mcl::bn::Fr* prefix = ScratchArena::local().make_array<mcl::bn::Fr>(n);
+        prefix[0] = values[0].value;
+        for (size_t i = 1; i < n; ++i) {
+            mcl::bn::Fr::mul(prefix[i], prefix[i - 1], values[i].value);
+        }
+        if (prefix[n - 1].isZero()) {
+            throw std::invalid_argument("batch_inverse: cannot invert zero.");
+        }
+
+        // Walk back down, peeling one factor off the running inverse per step
+        mcl::bn::Fr acc;
+        mcl::bn::Fr::inv(acc, prefix[n - 1]);
+        for (size_t i = n - 1; i > 0; --i) {
+            mcl::bn::Fr inv_i;
+            mcl::bn::Fr::mul(inv_i, acc, prefix[i - 1]);
+            mcl::bn::Fr::mul(acc, acc, values[i].value);
+            values[i].value = inv_i;
+        }
+        values[0].value = acc;
+    }
+
     Scalar Scalar::negate() const {
         Scalar result;
         mcl::bn::Fr::neg(result.value, this->value);
@@ -50,15 +201,22 @@ namespace ecgroup {
     std::string Scalar::to_string() const { return value.getStr(16); }
     Bytes Scalar::to_bytes() const {
         Bytes b(FR_SERIALIZED_SIZE);
-        value.serialize(b.data(), b.size());
+        write_to(b.data());
         return b;
     }
+    void Scalar::write_to(uint8_t* out) const {
+        value.serialize(out, FR_SERIALIZED_SIZE);
+    }
     Scalar Scalar::hash_to_scalar(const std::string& message) {
+        metrics::count(Counter::Hashes);
+        metrics::count(Counter::BytesHashed, message.size());
         Scalar s;
         s.value.setHashOf(message);
         return s;
     }
     Scalar Scalar::hash_to_scalar(const Bytes& data) {
+        metrics::count(Counter::Hashes);
+        metrics::count(Counter::BytesHashed, data.size());
         Scalar s;
         // setHashOf is designed to take raw byte buffers
         s.value.setHashOf(data.data(), data.size());
@@ -70,10 +228,17 @@ namespace ecgroup {
         return scalar;
     }
     Scalar Scalar::from_bytes(const Bytes& b) {
+        return read_from(b.data(), b.size());
+    }
+    Scalar Scalar::read_from(const uint8_t* in, size_t len) {
         Scalar scalar;
-        scalar.value.deserialize(b.data(), b.size());
+        if (scalar.value.deserialize(in, len) == 0) {
+            metrics::count(Counter::DecodeFailures);
+            throw std::invalid_argument("Invalid scalar encoding.");
+        }
         return scalar;
     }
+    bool Scalar::is_zero() const { return value.isZero(); }
     bool Scalar::operator==(const Scalar& other) const { return value == other.value; }
 
     Scalar Scalar::operator+(const Scalar& other) const {
@@ -92,9 +257,16 @@ namespace ecgroup {
     std::string G1Point::to_string() const { return value.getStr(16); }
     Bytes G1Point::to_bytes() const {
         Bytes b(G1_SERIALIZED_SIZE);
-        value.serialize(b.data(), b.size());
+        write_to(b.data());
         return b;
     }
+    void G1Point::write_to(uint8_t* out, PointEncoding encoding) const {
+        if (encoding == PointEncoding::Uncompressed) {
+            write_affine(value, out, G1_SERIALIZED_SIZE);
+            return;
+        }
+        value.serialize(out, G1_SERIALIZED_SIZE);
+    }
     G1Point G1Point::get_random() {
         Scalar s;
         s.set_random();
@@ -103,23 +275,66 @@ namespace ecgroup {
         return G1Point::mul(g1_generator, s);
     }
     G1Point G1Point::hash_and_map_to(const std::string& message) {
+        metrics::count(Counter::Hashes);
+        metrics::count(Counter::BytesHashed, message.size());
         G1Point p;
         mcl::bn::hashAndMapToG1(p.value, message.c_str(), message.length());
         return p;
     }
     G1Point G1Point::mul(const G1Point& p, const Scalar& s) {
+        metrics::count(Counter::G1Muls);
         G1Point result;
         mcl::bn::G1::mul(result.value, p.value, s.get_underlying());
         return result;
     }
+    G1Point G1Point::multi_mul(const std::vector<G1Point>& ps, const std::vector<Scalar>& ss) {
+        if (ps.size() != ss.size()) {
+            throw std::invalid_argument("multi_mul requires as many scalars as points.");
+        }
+        return multi_mul(ps.data(), ss.data(), ps.size());
+    }
+    G1Point G1Point::multi_mul(const G1Point* ps, const Scalar* ss, size_t n) {
+        metrics::count(Counter::G1Muls, n);
+        G1Point result;
+        if (n == 0) {
+            result.value.clear();
+            return result;
+        }
+
+        // mcl picks the strategy by size and may normalize the bases in place, so hand it copies
+        ScratchArena::Scope scope;
+        mcl::bn::G1* bases = ScratchArena::local().make_array<mcl::bn::G1>(n);
+        mcl::bn::Fr* scalars = ScratchArena::local().make_array<mcl::bn::Fr>(n);
+        for (size_t i = 0; i < n; ++i) {
+            bases[i] = ps[i].value;
+            scalars[i] = ss[i].get_underlying();
+        }
+        mcl::bn::G1::mulVec(result.value, bases, scalars, n);
+        return result;
+    }
     G1Point G1Point::from_string(const std::string& s) {
         G1Point p;
         p.value.setStr(s, 16);
+        // setStr only applies mcl's order check, which init_pairing turns off
+        validate_point(p.value, PointEncoding::Uncompressed, Validation::Full, Curve::G1_PRIME_ORDER);
         return p;
     }
-    G1Point G1Point::from_bytes(const Bytes& b) {
+    G1Point G1Point::from_bytes(const Bytes& b, Validation validation) {
+        return read_from(b.data(), b.size(), PointEncoding::Compressed, validation);
+    }
+    G1Point G1Point::read_from(const uint8_t* in, size_t len, PointEncoding encoding, Validation validation) {
         G1Point p;
-        p.value.deserialize(b.data(), b.size());
+        if (encoding == PointEncoding::Uncompressed) {
+            if (len < G1_UNCOMPRESSED_SIZE) {
+                metrics::count(Counter::DecodeFailures);
+                throw std::out_of_range("Not enough bytes for an uncompressed G1 point.");
+            }
+            read_affine(p.value, in, G1_SERIALIZED_SIZE);
+        } else if (p.value.deserialize(in, len) == 0) {
+            metrics::count(Counter::DecodeFailures);
+            throw std::invalid_argument("Invalid G1 point encoding.");
+        }
+        validate_point(p.value, encoding, validation, Curve::G1_PRIME_ORDER);
         return p;
     }
     G1Point G1Point::add(const G1Point& other) const {
@@ -127,6 +342,22 @@ namespace ecgroup {
         mcl::bn::G1::add(result.value, this->value, other.value);
         return result;
     }
+    void G1Point::normalize_batch(std::vector<G1Point>& points, size_t begin, size_t end) {
+        if (begin > end || end > points.size()) {
+            throw std::out_of_range("normalize_batch range exceeds the point vector.");
+        }
+        const size_t n = end - begin;
+        ScratchArena::Scope scope;
+        mcl::bn::G1* jacobian = ScratchArena::local().make_array<mcl::bn::G1>(n);
+        mcl::bn::G1* affine = ScratchArena::local().make_array<mcl::bn::G1>(n);
+        for (size_t i = begin; i < end; ++i) {
+            jacobian[i - begin] = points[i].value;
+        }
+        mcl::bn::G1::normalizeVec(affine, jacobian, n);
+        for (size_t i = begin; i < end; ++i) {
+            points[i].value = affine[i - begin];
+        }
+    }
     G1Point G1Point::negate() const {
         G1Point result;
         mcl::bn::G1::neg(result.value, this->value);
@@ -135,14 +366,75 @@ namespace ecgroup {
     bool G1Point::operator==(const G1Point& other) const { return value == other.value; }
     const mcl::bn::G1& G1Point::get_underlying() const { return value; }
 
+    // --- G1FixedBase Implementation ---
+    G1FixedBase::G1FixedBase() : window_bits(0), num_windows(0) {}
+
+    G1FixedBase::G1FixedBase(const G1Point& p, size_t w) : base(p), window_bits(w) {
+        if (w < 1 || w > 8) {
+            throw std::invalid_argument("G1FixedBase window must be between 1 and 8 bits.");
+        }
+        const size_t digits = (size_t(1) << w) - 1;
+        num_windows = (mcl::bn::Fr::getBitSize() + w - 1) / w;
+        table.resize(num_windows * digits);
+
+        // window_base = 2^(w*i) * base
+        ScratchArena::Scope scope;
+        mcl::bn::G1* jacobian = ScratchArena::local().make_array<mcl::bn::G1>(table.size());
+        mcl::bn::G1 window_base = base.get_underlying();
+        for (size_t i = 0; i < num_windows; ++i) {
+            mcl::bn::G1* row = &jacobian[i * digits];
+            row[0] = window_base;
+            for (size_t d = 1; d < digits; ++d) {
+                mcl::bn::G1::add(row[d], row[d - 1], window_base);
+            }
+            for (size_t k = 0; k < w; ++k) {
+                mcl::bn::G1::dbl(window_base, window_base);
+            }
+        }
+        // Affine entries let every lookup use a mixed addition; one shared inversion
+        // converts the whole table
+        mcl::bn::G1::normalizeVec(table.data(), jacobian, table.size());
+    }
+
+    G1Point G1FixedBase::mul(const Scalar& s) const {
+        if (table.empty()) {
+            throw std::logic_error("G1FixedBase used before initialization.");
+        }
+        metrics::count(Counter::G1Muls);
+        uint64_t words[SCALAR_WORDS];
+        scalar_to_words(s, words);
+
+        const size_t digits = (size_t(1) << window_bits) - 1;
+        G1Point result;
+        result.value.clear();
+        for (size_t i = 0; i < num_windows; ++i) {
+            size_t d = window_digit(words, i * window_bits, window_bits);
+            if (d != 0) {
+                mcl::bn::G1::add(result.value, result.value, table[i * digits + d - 1]);
+            }
+        }
+        return result;
+    }
+
+    const G1Point& G1FixedBase::get_base() const { return base; }
+    size_t G1FixedBase::get_window_bits() const { return window_bits; }
+    size_t G1FixedBase::table_size_bytes() const { return table.size() * sizeof(mcl::bn::G1); }
+
     // --- G2Point Implementation ---
     G2Point::G2Point() {}
     std::string G2Point::to_string() const { return value.getStr(16); }
     Bytes G2Point::to_bytes() const {
         Bytes b(G2_SERIALIZED_SIZE);
-        value.serialize(b.data(), b.size());
+        write_to(b.data());
         return b;
     }
+    void G2Point::write_to(uint8_t* out, PointEncoding encoding) const {
+        if (encoding == PointEncoding::Uncompressed) {
+            write_affine(value, out, G2_SERIALIZED_SIZE);
+            return;
+        }
+        value.serialize(out, G2_SERIALIZED_SIZE);
+    }
     G2Point G2Point::get_random() {
         Scalar s;
         s.set_random();
@@ -155,6 +447,7 @@ namespace ecgroup {
         return g;
     }
     G2Point G2Point::mul(const G2Point& p, const Scalar& s) {
+        metrics::count(Counter::G2Muls);
         G2Point result;
         mcl::bn::G2::mul(result.value, p.value, s.get_underlying());
         return result;
@@ -162,11 +455,26 @@ namespace ecgroup {
     G2Point G2Point::from_string(const std::string& s) {
         G2Point p;
         p.value.setStr(s, 16);
+        // setStr only applies mcl's order check, which init_pairing turns off
+        validate_point(p.value, PointEncoding::Uncompressed, Validation::Full, false);
         return p;
     }
-    G2Point G2Point::from_bytes(const Bytes& b) {
+    G2Point G2Point::from_bytes(const Bytes& b, Validation validation) {
+        return read_from(b.data(), b.size(), PointEncoding::Compressed, validation);
+    }
+    G2Point G2Point::read_from(const uint8_t* in, size_t len, PointEncoding encoding, Validation validation) {
         G2Point p;
-        p.value.deserialize(b.data(), b.size());
+        if (encoding == PointEncoding::Uncompressed) {
+            if (len < G2_UNCOMPRESSED_SIZE) {
+                metrics::count(Counter::DecodeFailures);
+                throw std::out_of_range("Not enough bytes for an uncompressed G2 point.");
+            }
+            read_affine(p.value, in, G2_SERIALIZED_SIZE);
+        } else if (p.value.deserialize(in, len) == 0) {
+            metrics::count(Counter::DecodeFailures);
+            throw std::invalid_argument("Invalid G2 point encoding.");
+        }
+        validate_point(p.value, encoding, validation, false);
         return p;
     }
     G2Point G2Point::add(const G2Point& other) const {
@@ -177,13 +485,23 @@ namespace ecgroup {
     bool G2Point::operator==(const G2Point& other) const { return value == other.value; }
     const mcl::bn::G2& G2Point::get_underlying() const { return value; }
 
+    // --- PreparedG2Point Implementation ---
+    PreparedG2Point::PreparedG2Point() {}
+    PreparedG2Point::PreparedG2Point(const G2Point& q) : point(q) {
+        mcl::bn::precomputeG2(coefficients, q.get_underlying());
+    }
+    const G2Point& PreparedG2Point::get_point() const { return point; }
+    const std::vector<mcl::bn::Fp6>& PreparedG2Point::get_coefficients() const { return coefficients; }
+
     // --- PairingResult Implementation ---
     PairingResult::PairingResult() {}
     PairingResult::PairingResult(const mcl::bn::Fp12& v) : value(v) {}
     bool PairingResult::operator==(const PairingResult& other) const { return value == other.value; }
+    bool PairingResult::is_one() const { return value.isOne(); }
     const mcl::bn::Fp12& PairingResult::get_underlying() const { return value; }
 
     PairingResult PairingResult::pow(const Scalar& s) const {
+        metrics::count(Counter::GTExps);
         PairingResult result;
         mcl::bn::Fp12::pow(result.value, this->value, s.get_underlying());
         return result;
@@ -210,17 +528,182 @@ namespace ecgroup {
         return PairingResult::div(*this, other);
     }
 
+    // --- GTFixedBase Implementation ---
+    GTFixedBase::GTFixedBase() : window_bits(0), num_windows(0) {}
+
+    GTFixedBase::GTFixedBase(const PairingResult& b, size_t w) : base(b), window_bits(w) {
+        if (w < 1 || w > 8) {
+            throw std::invalid_argument("GTFixedBase window must be between 1 and 8 bits.");
+        }
+        const size_t digits = (size_t(1) << w) - 1;
+        num_windows = (mcl::bn::Fr::getBitSize() + w - 1) / w;
+        table.resize(num_windows * digits);
+        one.setOne();
+
+        // window_base = base^(2^(w*i))
+        mcl::bn::Fp12 window_base = base.get_underlying();
+        for (size_t i = 0; i < num_windows; ++i) {
+            mcl::bn::Fp12* row = &table[i * digits];
+            row[0] = window_base;
+            for (size_t d = 1; d < digits; ++d) {
+                mcl::bn::Fp12::mul(row[d], row[d - 1], window_base);
+            }
+            for (size_t k = 0; k < w; ++k) {
+                mcl::bn::Fp12::sqr(window_base, window_base);
+            }
+        }
+    }
+
+    PairingResult GTFixedBase::pow(const Scalar& s) const {
+        if (table.empty()) {
+            throw std::logic_error("GTFixedBase used before initialization.");
+        }
+        metrics::count(Counter::GTExps);
+        uint64_t words[SCALAR_WORDS];
+        scalar_to_words(s, words);
+
+        const size_t digits = (size_t(1) << window_bits) - 1;
+        mcl::bn::Fp12 result = one;
+        for (size_t i = 0; i < num_windows; ++i) {
+            size_t d = window_digit(words, i * window_bits, window_bits);
+            if (d != 0) {
+                mcl::bn::Fp12::mul(result, result, table[i * digits + d - 1]);
+            }
+        }
+        return PairingResult(result);
+    }
+
+    const PairingResult& GTFixedBase::get_base() const { return base; }
+    size_t GTFixedBase::table_size_bytes() const { return table.size() * sizeof(mcl::bn::Fp12); }
+    void GTFixedBase::wipe() {
+        secure_wipe(&base, sizeof(base));
+        secure_wipe(table.data(), table_size_bytes());
+    }
+
     // --- Pairing Function Implementation ---
+    Transcript::Transcript() {}
+
+    void Transcript::absorb(const uint8_t* data, size_t len) {
+        metrics::count(Counter::BytesHashed, len);
+        hash.update(data, len);
+    }
+    void Transcript::absorb(const Bytes& data) {
+        absorb(data.data(), data.size());
+    }
+    void Transcript::absorb(const G1Point& p) {
+        uint8_t buf[G1_SERIALIZED_SIZE];
+        p.write_to(buf);
+        absorb(buf, sizeof(buf));
+    }
+    void Transcript::absorb(const PairingResult& gt) {
+        uint8_t buf[GT_SERIALIZED_SIZE];
+        gt.write_to(buf);
+        absorb(buf, sizeof(buf));
+    }
+    void Transcript::absorb_compressed(const PairingResult& gt) {
+        uint8_t buf[GT_COMPRESSED_SIZE];
+        gt.write_compressed_to(buf);
+        absorb(buf, sizeof(buf));
+    }
+    Scalar Transcript::challenge() {
+        metrics::count(Counter::Hashes);
+        // Fr::setHashOf is SHA-256 followed by setDigest for fields of up to 256 bits
+        static_assert(FR_SERIALIZED_SIZE <= 32, "Transcript assumes a SHA-256 sized scalar field");
+        uint8_t md[32];
+        size_t md_size = hash.digest(md, sizeof(md));
+        Scalar s;
+        s.get_underlying().setDigest(md, md_size);
+        return s;
+    }
+
     PairingResult pairing(const G1Point& p, const G2Point& q) {
+        metrics::count(Counter::Pairings);
         mcl::bn::Fp12 e;
         mcl::bn::pairing(e, p.get_underlying(), q.get_underlying());
         return PairingResult(e);
     }
 
+    PairingResult pairing(const G1Point& p, const PreparedG2Point& q) {
+        metrics::count(Counter::Pairings);
+        mcl::bn::Fp12 f, e;
+        mcl::bn::precomputedMillerLoop(f, p.get_underlying(), q.get_coefficients());
+        mcl::bn::finalExp(e, f);
+        return PairingResult(e);
+    }
+
+    PairingResult multi_pairing(const std::vector<G1Point>& ps, const std::vector<G2Point>& qs) {
+        if (ps.size() != qs.size() || ps.empty()) {
+            throw std::invalid_argument("multi_pairing requires equally sized, non-empty inputs.");
+        }
+
+        metrics::count(Counter::Pairings, ps.size());
+        ScratchArena::Scope scope;
+        mcl::bn::G1* g1s = ScratchArena::local().make_array<mcl::bn::G1>(ps.size());
+        mcl::bn::G2* g2s = ScratchArena::local().make_array<mcl::bn::G2>(qs.size());
+        for (size_t i = 0; i < ps.size(); ++i) {
+            g1s[i] = ps[i].get_underlying();
+            g2s[i] = qs[i].get_underlying();
+        }
+
+        mcl::bn::Fp12 f, e;
+        mcl::bn::millerLoopVec(f, g1s, g2s, ps.size());
+        mcl::bn::finalExp(e, f);
+        return PairingResult(e);
+    }
+
+    PairingResult multi_pairing(const G1Point& p1, const G2Point& q1, const G1Point& p2, const G2Point& q2) {
+        metrics::count(Counter::Pairings, 2);
+        const mcl::bn::G1 g1s[2] = {p1.get_underlying(), p2.get_underlying()};
+        const mcl::bn::G2 g2s[2] = {q1.get_underlying(), q2.get_underlying()};
+
+        mcl::bn::Fp12 f, e;
+        mcl::bn::millerLoopVec(f, g1s, g2s, 2);
+        mcl::bn::finalExp(e, f);
+        return PairingResult(e);
+    }
+
+    PairingResult multi_pairing(const G1Point& p1, const PreparedG2Point& q1, const G1Point& p2, const PreparedG2Point& q2) {
+        metrics::count(Counter::Pairings, 2);
+        mcl::bn::Fp12 f, e;
+        mcl::bn::precomputedMillerLoop2(f, p1.get_underlying(), q1.get_coefficients(),
+                                        p2.get_underlying(), q2.get_coefficients());
+        mcl::bn::finalExp(e, f);
+        return PairingResult(e);
+    }
+
     Bytes PairingResult::to_bytes() const {
         Bytes b(GT_SERIALIZED_SIZE);
-        value.serialize(b.data(), b.size());
+        write_to(b.data());
         return b;
     }
+    void PairingResult::write_to(uint8_t* out) const {
+        value.serialize(out, GT_SERIALIZED_SIZE);
+    }
+    void PairingResult::write_compressed_to(uint8_t* out) const {
+        const mcl::bn::Fp6& b = value.b;
+        if (b.isZero()) {
+            out[0] = 1;
+            std::fill(out + 1, out + GT_COMPRESSED_SIZE, 0);
+            return;
+        }
+        mcl::bn::Fp6 num = value.a;
+        num.a.a += mcl::bn::Fp::one();
+        mcl::bn::Fp6 b_inv, c;
+        mcl::bn::Fp6::inv(b_inv, b);
+        mcl::bn::Fp6::mul(c, num, b_inv);
+        out[0] = 0;
+        c.serialize(out + 1, GT_COMPRESSED_SIZE - 1);
+    }
+    PairingResult PairingResult::from_bytes(const Bytes& b) {
+        return read_from(b.data(), b.size());
+    }
+    PairingResult PairingResult::read_from(const uint8_t* in, size_t len) {
+        PairingResult r;
+        if (r.value.deserialize(in, len) == 0) {
+            metrics::count(Counter::DecodeFailures);
+            throw std::invalid_argument("Invalid GT element encoding.");
+        }
+        return r;
+    }
 
 } // namespace ecgroup
\ No newline at end of file
@@ -1,7 +1,9 @@
 #ifndef SHIM_ECGROUP_HPP
 #define SHIM_ECGROUP_HPP
 
+#include <cybozu/sha2.hpp>
 #include <mcl/bn.hpp>
+#include "curve.hpp"
 #include <vector>
 #include <string>
 
@@ -10,17 +12,63 @@ namespace ecgroup {
     // Define a byte vector type for clarity
     using Bytes = std::vector<uint8_t>;
 
-    // These sizes are consistent with MCL's default serialization for BN256
-    constexpr size_t FR_SERIALIZED_SIZE = 32;
-    constexpr size_t G1_SERIALIZED_SIZE = 32; // MCL serializes G1 in compressed form by default
-    constexpr size_t G2_SERIALIZED_SIZE = 64; // MCL serializes G2 in compressed form by default
-    constexpr size_t GT_SERIALIZED_SIZE = 384;
+    // These sizes are consistent with MCL's default serialization for the selected curve
+    constexpr size_t FR_SERIALIZED_SIZE = Curve::FR_SIZE;
+    constexpr size_t G1_SERIALIZED_SIZE = Curve::FP_SIZE;      // MCL serializes G1 in compressed form by default
+    constexpr size_t G2_SERIALIZED_SIZE = 2 * Curve::FP_SIZE;  // MCL serializes G2 in compressed form by default
+    constexpr size_t GT_SERIALIZED_SIZE = 12 * Curve::FP_SIZE;
+    // Affine (x, y) encodings: twice the size, but loading them needs no square root
+    constexpr size_t G1_UNCOMPRESSED_SIZE = 2 * G1_SERIALIZED_SIZE;
+    constexpr size_t G2_UNCOMPRESSED_SIZE = 2 * G2_SERIALIZED_SIZE;
+    // Torus-compressed GT: one marker byte and an Fp6 element (half of an Fp12)
+    constexpr size_t GT_COMPRESSED_SIZE = 1 + GT_SERIALIZED_SIZE / 2;
+
+    /**
+     * How points are written. Compressed is the canonical wire format. Uncompressed
+     * stores affine x and y and is meant for data this process wrote itself (key
+     * stores, logs, caches): decoding it needs no square root.
+     */
+    enum class PointEncoding : uint8_t {
+        Compressed,
+        Uncompressed,
+    };
+
+    /**
+     * What point decoding checks. init_pairing() turns off mcl's implicit order checks
+     * so that the cost is chosen per call instead of process-wide:
+     *  - Full: on the curve and in the prime-order subgroup. The subgroup test is mcl's
+     *    endomorphism-based isValidOrder(), not a multiplication by the group order.
+     *    It is skipped for G1 when Curve::G1_PRIME_ORDER (BN254), where being on the
+     *    curve already implies it; on BLS12-381 G1 has a cofactor and it runs.
+     *  - OnCurve: on the curve only. Costs the same as Full for G1 on BN254; never
+     *    enough for G2, or for G1 on BLS12-381.
+     *  - Trusted: no curve checks at all; only for bytes this process wrote itself.
+     * Every policy rejects malformed encodings and non-canonical field elements.
+     * A compressed point is on the curve by construction, so OnCurve and Trusted cost
+     * the same for it; they differ for uncompressed points.
+     */
+    enum class Validation : uint8_t {
+        Full,
+        OnCurve,
+        Trusted,
+    };
+
+    constexpr size_t g1_size(PointEncoding encoding) {
+        return encoding == PointEncoding::Compressed ? G1_SERIALIZED_SIZE : G1_UNCOMPRESSED_SIZE;
+    }
+
+    constexpr size_t g2_size(PointEncoding encoding) {
+        return encoding == PointEncoding::Compressed ? G2_SERIALIZED_SIZE : G2_UNCOMPRESSED_SIZE;
+    }
 
     class G1Point;
     class G2Point;
     class PairingResult;
+    class PreparedG2Point;
     class Scalar;
 
+    // Initializes mcl for the curve selected at build time (Curve). Also disables
+    // mcl's implicit order checks on deserialization; see Validation.
     void init_pairing();
 
     class Scalar {
@@ -28,9 +76,15 @@ namespace ecgroup {
         Scalar();
         Scalar(const mcl::bn::Fr& v): value(v) {};
 
+        // Uniform over the group order; drawn from random_bytes() (see random.hpp).
         void set_random();
         static Scalar get_random();
+        // n independent random scalars from as few generator calls as possible.
+        static void fill_random(Scalar* out, size_t n);
         Scalar inverse() const;
+        // Inverts values[0..n) in place with one field inversion (Montgomery's trick).
+        // Throws std::invalid_argument, leaving values unchanged, if any of them is zero.
+        static void batch_inverse(Scalar* values, size_t n);
         Scalar negate() const;
         static Scalar add(const Scalar& a, const Scalar& b);
         static Scalar mul(const Scalar& a, const Scalar& b);
@@ -38,12 +92,18 @@ namespace ecgroup {
 
         std::string to_string() const;
         Bytes to_bytes() const;
+        // Writes exactly FR_SERIALIZED_SIZE bytes to out.
+        void write_to(uint8_t* out) const;
 
         static Scalar hash_to_scalar(const std::string& message);
         static Scalar hash_to_scalar(const Bytes& data);
         static Scalar from_string(const std::string& s);
         static Scalar from_bytes(const Bytes& b);
+        // Decodes straight from the caller's buffer; len is the number of readable bytes.
+        // Throws std::invalid_argument unless the input is a canonical field element.
+        static Scalar read_from(const uint8_t* in, size_t len);
 
+        bool is_zero() const;
         bool operator==(const Scalar& other) const;
         Scalar operator+(const Scalar& other) const;
         Scalar operator*(const Scalar& other) const;
@@ -61,35 +121,79 @@ namespace ecgroup {
 
         std::string to_string() const;
         Bytes to_bytes() const;
+        // Writes exactly g1_size(encoding) bytes to out.
+        void write_to(uint8_t* out, PointEncoding encoding = PointEncoding::Compressed) const;
 
         static G1Point get_random();
         static G1Point hash_and_map_to(const std::string& message);
         static G1Point mul(const G1Point& p, const Scalar& s);
+        // Sum of ps[i]^ss[i] with a shared doubling chain (interleaved GLV/wNAF for few terms, Pippenger for many).
+        static G1Point multi_mul(const std::vector<G1Point>& ps, const std::vector<Scalar>& ss);
+        // Same over n points and n scalars; no heap allocation in steady state.
+        static G1Point multi_mul(const G1Point* ps, const Scalar* ss, size_t n);
+        // Always checks subgroup membership (Validation::Full).
         static G1Point from_string(const std::string& s);
-        static G1Point from_bytes(const Bytes& b);
+        static G1Point from_bytes(const Bytes& b, Validation validation = Validation::Full);
+        // Decodes straight from the caller's buffer; len is the number of readable bytes.
+        // Throws std::invalid_argument if the point fails the requested validation.
+        static G1Point read_from(const uint8_t* in, size_t len, PointEncoding encoding = PointEncoding::Compressed,
+                               Validation validation = Validation::Full);
         G1Point add(const G1Point& other) const;
         G1Point negate() const;
+        // Converts points[begin, end) to affine coordinates with a single shared inversion.
+        static void normalize_batch(std::vector<G1Point>& points, size_t begin, size_t end);
 
         bool operator==(const G1Point& other) const;
 
         const mcl::bn::G1& get_underlying() const;
 
     private:
+        friend class G1FixedBase;
         mcl::bn::G1 value;
     };
 
+    /**
+     * Windowed fixed-base table for a G1 point that is multiplied many times.
+     * Stores d * 2^(w*i) * base for every window i and digit d, so a multiplication
+     * is one mixed addition per window and no doublings. Memory grows as 2^w / w.
+     */
+    class G1FixedBase {
+    public:
+        G1FixedBase();
+        explicit G1FixedBase(const G1Point& base, size_t window_bits = 4);
+
+        G1Point mul(const Scalar& s) const;
+
+        const G1Point& get_base() const;
+        size_t get_window_bits() const;
+        size_t table_size_bytes() const;
+
+    private:
+        G1Point base;
+        size_t window_bits;
+        size_t num_windows;
+        std::vector<mcl::bn::G1> table;
+    };
+
     class G2Point {
     public:
         G2Point();
 
         std::string to_string() const;
         Bytes to_bytes() const;
+        // Writes exactly g2_size(encoding) bytes to out.
+        void write_to(uint8_t* out, PointEncoding encoding = PointEncoding::Compressed) const;
 
         static G2Point get_random();
         static G2Point get_generator();
         static G2Point mul(const G2Point& p, const Scalar& s);
+        // Always checks subgroup membership (Validation::Full).
         static G2Point from_string(const std::string& s);
-        static G2Point from_bytes(const Bytes& b);
+        static G2Point from_bytes(const Bytes& b, Validation validation = Validation::Full);
+        // Decodes straight from the caller's buffer; len is the number of readable bytes.
+        // Throws std::invalid_argument if the point fails the requested validation.
+        static G2Point read_from(const uint8_t* in, size_t len, PointEncoding encoding = PointEncoding::Compressed,
+                               Validation validation = Validation::Full);
         G2Point add(const G2Point& other) const;
 
         bool operator==(const G2Point& other) const;
@@ -100,15 +204,44 @@ namespace ecgroup {
         mcl::bn::G2 value;
     };
 
+    /**
+     * A G2 point together with its precomputed Miller-loop line coefficients.
+     * Pairings against it skip the G2 side of the Miller loop entirely.
+     */
+    class PreparedG2Point {
+    public:
+        PreparedG2Point();
+        explicit PreparedG2Point(const G2Point& q);
+
+        const G2Point& get_point() const;
+        const std::vector<mcl::bn::Fp6>& get_coefficients() const;
+
+    private:
+        G2Point point;
+        std::vector<mcl::bn::Fp6> coefficients;
+    };
+
     class PairingResult {
     public:
         PairingResult();
         explicit PairingResult(const mcl::bn::Fp12& v);
 
         bool operator==(const PairingResult& other) const;
+        bool is_one() const;
         const mcl::bn::Fp12& get_underlying() const;
 
         Bytes to_bytes() const;
+        // Writes exactly GT_SERIALIZED_SIZE bytes to out.
+        void write_to(uint8_t* out) const;
+        static PairingResult from_bytes(const Bytes& b);
+        static PairingResult read_from(const uint8_t* in, size_t len);
+        /**
+         * Writes GT_COMPRESSED_SIZE bytes of the torus (T2) compression of this element.
+         * Writing it as a + b*w over Fp6, a GT element has norm 1, so it is fixed by
+         * (1 + a) / b alone; b == 0 only for the identity, which gets its own marker.
+         * The encoding is injective on GT, which is all a transcript needs.
+         */
+        void write_compressed_to(uint8_t* out) const;
         
         // Exponentiation and multiplication
         PairingResult pow(const Scalar& s) const;
@@ -123,7 +256,62 @@ namespace ecgroup {
         mcl::bn::Fp12 value;
     };
 
+    /**
+     * Windowed fixed-base table for a GT element raised to many exponents, the GT
+     * counterpart of G1FixedBase: one Fp12 multiplication per window, no squarings.
+     */
+    class GTFixedBase {
+    public:
+        GTFixedBase();
+        explicit GTFixedBase(const PairingResult& base, size_t window_bits = 4);
+
+        PairingResult pow(const Scalar& s) const;
+
+        const PairingResult& get_base() const;
+        size_t table_size_bytes() const;
+        // Zeroes the base and every table entry, for tables built from secret bases.
+        void wipe();
+
+    private:
+        PairingResult base;
+        mcl::bn::Fp12 one;
+        size_t window_bits;
+        size_t num_windows;
+        std::vector<mcl::bn::Fp12> table;
+    };
+
+    /**
+     * Incremental Fiat-Shamir hasher. Absorbing values one after another and calling
+     * challenge() gives the same scalar as Scalar::hash_to_scalar over their
+     * concatenated encodings, without ever building that concatenation: points are
+     * serialized into a stack buffer and byte ranges are hashed in place.
+     */
+    class Transcript {
+    public:
+        Transcript();
+
+        void absorb(const uint8_t* data, size_t len);
+        void absorb(const Bytes& data);
+        void absorb(const G1Point& p);
+        void absorb(const PairingResult& gt);
+        // Absorbs the torus-compressed encoding instead of the full Fp12 serialization.
+        void absorb_compressed(const PairingResult& gt);
+
+        // Finishes the hash; the transcript must not be absorbed into afterwards.
+        Scalar challenge();
+
+    private:
+        cybozu::Sha256 hash;
+    };
+
     PairingResult pairing(const G1Point& p, const G2Point& q);
+    PairingResult pairing(const G1Point& p, const PreparedG2Point& q);
+
+    // Product of e(ps[i], qs[i]): the Miller loops are accumulated and share one final exponentiation.
+    PairingResult multi_pairing(const std::vector<G1Point>& ps, const std::vector<G2Point>& qs);
+    // e(p1, q1) * e(p2, q2), the shape every protocol pairing in bbsgs takes.
+    PairingResult multi_pairing(const G1Point& p1, const G2Point& q1, const G1Point& p2, const G2Point& q2);
+    PairingResult multi_pairing(const G1Point& p1, const PreparedG2Point& q1, const G1Point& p2, const PreparedG2Point& q2);
 
 } // namespace ecgroup
 
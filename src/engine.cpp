@@ -0,0 +1,139 @@
+#include "engine.hpp"
+#include <algorithm>
+
+namespace bbsgs {
+
+    namespace {
+        // Upper bound on the jobs one drain task takes, so a hot key can't starve the others
+        constexpr size_t MAX_VERIFY_GROUP = 64;
+    } // namespace
+
+    VerifyEngine::VerifyEngine(size_t num_threads, size_t max_cached)
+        : max_cached_keys(std::max<size_t>(max_cached, 1)), pool(num_threads) {}
+
+    size_t VerifyEngine::num_threads() const {
+        return pool.size();
+    }
+
+    std::shared_ptr<VerifyEngine::KeyState> VerifyEngine::key_state(const GroupPublicKey& gpk) {
+        ecgroup::Bytes id = gpk.to_bytes();
+        std::string cache_key(id.begin(), id.end());
+
+        std::shared_ptr<KeyState> state;
+        {
+            std::lock_guard<std::mutex> lock(keys_mutex);
+            auto it = keys.find(cache_key);
+            if (it != keys.end()) {
+                lru.splice(lru.begin(), lru, it->second.lru_pos);
+                state = it->second.state;
+            } else {
+                state = std::make_shared<KeyState>();
+                lru.push_front(cache_key);
+                keys.emplace(std::move(cache_key), CachedKey{state, lru.begin()});
+                if (keys.size() > max_cached_keys) {
+                    keys.erase(lru.back());
+                    lru.pop_back();
+                }
+            }
+        }
+
+        // Built outside keys_mutex so preparing one key never stalls lookups of the
+        // others; concurrent first users of this key wait here for a single build.
+        // If the build throws, the flag stays unset and the next caller retries.
+        std::call_once(state->prepare_once, [&]() {
+            state->pgpk = std::make_shared<const PreparedGroupPublicKey>(gpk);
+        });
+        return state;
+    }
+
+    void VerifyEngine::enqueue_verify(const GroupPublicKey& gpk, VerifyJob job) {
+        std::shared_ptr<KeyState> state = key_state(gpk);
+
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->pending.push_back(std::move(job));
+            if (!state->scheduled) {
+                state->scheduled = true;
+                schedule = true;
+            }
+        }
+        if (schedule) {
+            pool.submit([this, state]() { drain(state); });
+        }
+    }
+
+    void VerifyEngine::drain(std::shared_ptr<KeyState> state) {
+        std::vector<VerifyJob> group;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            size_t n = std::min(state->pending.size(), MAX_VERIFY_GROUP);
+            group.assign(std::make_move_iterator(state->pending.begin()),
+                         std::make_move_iterator(state->pending.begin() + n));
+            state->pending.erase(state->pending.begin(), state->pending.begin() + n);
+
+            // Leftovers get a fresh task so other keys and other work can interleave
+            if (state->pending.empty()) {
+                state->scheduled = false;
+            } else {
+                pool.submit([this, state]() { drain(state); });
+            }
+        }
+
+        std::vector<ecgroup::Bytes> messages;
+        std::vector<GroupSignature> sigmas;
+        messages.reserve(group.size());
+        sigmas.reserve(group.size());
+        for (auto& job : group) {
+            messages.push_back(std::move(job.message));
+            sigmas.push_back(job.sigma);
+        }
+
+        std::vector<bool> results(group.size(), false);
+        try {
+            bbs04_verify_batch(*state->pgpk, messages, sigmas, &results);
+        } catch (...) {
+            results.assign(group.size(), false);
+        }
+        for (size_t i = 0; i < group.size(); ++i) {
+            // A throwing callback must not escape the worker (std::terminate) or skip the rest
+            try {
+                group[i].on_done(results[i]);
+            } catch (...) {
+            }
+        }
+    }
+
+    std::future<bool> VerifyEngine::verify(const GroupPublicKey& gpk, ecgroup::Bytes message, GroupSignature sigma) {
+        auto promise = std::make_shared<std::promise<bool>>();
+        std::future<bool> result = promise->get_future();
+        verify(gpk, std::move(message), std::move(sigma), [promise](bool ok) { promise->set_value(ok); });
+        return result;
+    }
+
+    void VerifyEngine::verify(const GroupPublicKey& gpk, ecgroup::Bytes message, GroupSignature sigma,
+                              std::function<void(bool)> on_done) {
+        enqueue_verify(gpk, VerifyJob{std::move(message), std::move(sigma), std::move(on_done)});
+    }
+
+    std::future<GroupSignature> VerifyEngine::sign(const GroupPublicKey& gpk, UserSecretKey usk, ecgroup::Bytes message) {
+        auto task = std::make_shared<std::packaged_task<GroupSignature()>>(
+            [pgpk = key_state(gpk)->pgpk, usk = std::move(usk), message = std::move(message)]() {
+                return bbs04_sign(*pgpk, usk, message);
+            });
+        std::future<GroupSignature> result = task->get_future();
+        pool.submit([task]() { (*task)(); });
+        return result;
+    }
+
+    std::future<ecgroup::G1Point> VerifyEngine::open(const GroupPublicKey& gpk, OpenerSecretKey osk, GroupSignature sigma) {
+        auto task = std::make_shared<std::packaged_task<ecgroup::G1Point()>>(
+            [gpk, osk = std::move(osk), sigma = std::move(sigma)]() {
+                return bbs04_open(gpk, osk, sigma);
+            });
+        std::future<ecgroup::G1Point> result = task->get_future();
+        pool.submit([task]() { (*task)(); });
+        return result;
+    }
+
+} // namespace bbsgs
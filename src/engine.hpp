@@ -0,0 +1,92 @@
+#ifndef BBSGS_ENGINE_HPP
+#define BBSGS_ENGINE_HPP
+
+#include "signature.hpp"
+#include "thread_pool.hpp"
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bbsgs {
+
+    /**
+     * Asynchronous sign/verify/open service on a work-stealing pool.
+     *
+     * Verify jobs are grouped per group public key: jobs for the same key queue up
+     * behind one prepared key and are drained by a single task through
+     * bbs04_verify_batch, so key preparation is paid once per cached key and a burst
+     * of verifies becomes one batch. At most max_cached_keys prepared keys are kept;
+     * the least recently used one is dropped first (in-flight jobs keep theirs alive).
+     *
+     * Concurrency contract of the layers below, which the engine relies on:
+     *  - ecgroup::init_pairing() must complete before the engine is created and must
+     *    never run concurrently with any other call.
+     *  - After that, every ecgroup and bbsgs operation only reads the immutable curve
+     *    parameters and may run on any number of threads at once.
+     *  - Random scalars come from a per-thread ChaCha20 generator (see random.hpp), so
+     *    signing threads never contend on it. An installed RandomSource is shared and
+     *    must be thread-safe.
+     *  - Prepared keys are immutable after construction and are shared freely.
+     */
+    class VerifyEngine {
+    public:
+        // num_threads == 0 means one worker per hardware thread.
+        explicit VerifyEngine(size_t num_threads = 0, size_t max_cached_keys = 64);
+
+        VerifyEngine(const VerifyEngine&) = delete;
+        VerifyEngine& operator=(const VerifyEngine&) = delete;
+
+        std::future<bool> verify(const GroupPublicKey& gpk, ecgroup::Bytes message, GroupSignature sigma);
+        // on_done runs on a worker thread; an error is reported as an invalid signature.
+        // Exceptions thrown by on_done are caught and dropped.
+        void verify(const GroupPublicKey& gpk, ecgroup::Bytes message, GroupSignature sigma,
+                    std::function<void(bool)> on_done);
+
+        std::future<GroupSignature> sign(const GroupPublicKey& gpk, UserSecretKey usk, ecgroup::Bytes message);
+        std::future<ecgroup::G1Point> open(const GroupPublicKey& gpk, OpenerSecretKey osk, GroupSignature sigma);
+
+        size_t num_threads() const;
+
+    private:
+        struct VerifyJob {
+            ecgroup::Bytes message;
+            GroupSignature sigma;
+            std::function<void(bool)> on_done;
+        };
+
+        struct KeyState {
+            // Set once under prepare_once; readers go through key_state(), which waits for it
+            std::once_flag prepare_once;
+            std::shared_ptr<const PreparedGroupPublicKey> pgpk;
+            std::mutex mutex;
+            std::vector<VerifyJob> pending;
+            bool scheduled = false;
+        };
+
+        struct CachedKey {
+            std::shared_ptr<KeyState> state;
+            std::list<std::string>::iterator lru_pos;
+        };
+
+        std::shared_ptr<KeyState> key_state(const GroupPublicKey& gpk);
+        void enqueue_verify(const GroupPublicKey& gpk, VerifyJob job);
+        void drain(std::shared_ptr<KeyState> state);
+
+        const size_t max_cached_keys;
+        std::mutex keys_mutex;
+        std::unordered_map<std::string, CachedKey> keys;
+        // Most recently used key first
+        std::list<std::string> lru;
+
+        // Declared last so the workers stop before the key states they use are destroyed
+        WorkStealingPool pool;
+    };
+
+} // namespace bbsgs
+
+#endif // BBSGS_ENGINE_HPP
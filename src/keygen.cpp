@@ -1,4 +1,10 @@
 #include "keygen.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace bbsgs {
 
@@ -25,4 +31,89 @@ namespace bbsgs {
         return usk;
     }
 
+    UserSecretKey bbs04_user_keygen(IssuerSecretKey const &isk, PreparedGroupPublicKey const &pgpk) {
+        UserSecretKey usk;
+        usk.x = ecgroup::Scalar::get_random();
+        ecgroup::Scalar gamma_plus_x = ecgroup::Scalar::add(isk.gamma, usk.x);
+        usk.A = pgpk.g1.mul(gamma_plus_x.inverse());
+        return usk;
+    }
+
+    size_t bbs04_user_keygen_batch(IssuerSecretKey const &isk, PreparedGroupPublicKey const &pgpk,
+                                   size_t count, UserKeySink const &sink, size_t num_threads) {
+        if (count == 0) {
+            return 0;
+        }
+        const size_t chunks = (count + KEYGEN_CHUNK - 1) / KEYGEN_CHUNK;
+        if (num_threads == 0) {
+            num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        num_threads = std::min(num_threads, chunks);
+
+        std::atomic<size_t> next_chunk(0);
+        std::atomic<bool> stop(false);
+        std::mutex sink_mutex;
+        std::exception_ptr error;
+        size_t issued = 0;
+
+        auto issue = [&]() {
+            std::vector<ecgroup::Scalar> xs(KEYGEN_CHUNK);
+            std::vector<ecgroup::Scalar> inverses(KEYGEN_CHUNK);
+            std::vector<ecgroup::G1Point> as(KEYGEN_CHUNK);
+            UserSecretKey usk;
+            try {
+                for (size_t c = next_chunk++; c < chunks && !stop.load(std::memory_order_relaxed); c = next_chunk++) {
+                    const size_t begin = c * KEYGEN_CHUNK;
+                    const size_t n = std::min(KEYGEN_CHUNK, count - begin);
+
+                    ecgroup::Scalar::fill_random(xs.data(), n);
+                    for (size_t i = 0; i < n; ++i) {
+                        inverses[i] = isk.gamma + xs[i];
+                        // Negligibly likely, but a zero would poison the shared inversion
+                        while (inverses[i].is_zero()) {
+                            xs[i].set_random();
+                            inverses[i] = isk.gamma + xs[i];
+                        }
+                    }
+                    ecgroup::Scalar::batch_inverse(inverses.data(), n);
+                    for (size_t i = 0; i < n; ++i) {
+                        as[i] = pgpk.g1.mul(inverses[i]);
+                    }
+                    // Affine points serialize without a further inversion each
+                    ecgroup::G1Point::normalize_batch(as, 0, n);
+
+                    std::lock_guard<std::mutex> lock(sink_mutex);
+                    for (size_t i = 0; i < n && !stop.load(std::memory_order_relaxed); ++i) {
+                        usk.x = xs[i];
+                        usk.A = as[i];
+                        ++issued;
+                        if (!sink(begin + i, usk)) {
+                            stop = true;
+                        }
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(sink_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                stop = true;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads - 1);
+        for (size_t t = 1; t < num_threads; ++t) {
+            workers.emplace_back(issue);
+        }
+        issue();
+        for (auto& w : workers) {
+            w.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return issued;
+    }
+
 } // namespace bbsgs
\ No newline at end of file
@@ -2,11 +2,30 @@
 #define BBSGS_SETUP_HPP
 
 #include "keys.hpp"
+#include <functional>
 
 namespace bbsgs {
 
     void bbs04_setup(GroupPublicKey &gpk, OpenerSecretKey &osk, IssuerSecretKey &sk);
     UserSecretKey bbs04_user_keygen(IssuerSecretKey const &isk, GroupPublicKey const &gpk);
+    UserSecretKey bbs04_user_keygen(IssuerSecretKey const &isk, PreparedGroupPublicKey const &pgpk);
+
+    // Receives key number index of a batch; returns false to stop issuing.
+    using UserKeySink = std::function<bool(size_t index, UserSecretKey const &usk)>;
+
+    constexpr size_t KEYGEN_CHUNK = 1024;
+
+    /**
+     * Issues count user keys and streams each one to sink instead of returning them, so
+     * memory stays bounded however large the batch. Keys are made in chunks of
+     * KEYGEN_CHUNK on num_threads workers (0 = one per core); a chunk shares a single
+     * field inversion for all (gamma + x_i) and multiplies the precomputed g1 table.
+     * Chunks finish in any order, but sink is never called concurrently. If sink
+     * returns false or throws, no further keys are issued and the exception is
+     * rethrown here. Returns the number of keys passed to sink.
+     */
+    size_t bbs04_user_keygen_batch(IssuerSecretKey const &isk, PreparedGroupPublicKey const &pgpk,
+                                   size_t count, UserKeySink const &sink, size_t num_threads = 0);
 
 } // namespace bbsgs
 
@@ -1,165 +1,263 @@
 #include "keys.hpp"
-#include <stdexcept> // Required for std::out_of_range
+#include "metrics.hpp"
+#include "random.hpp"
+#include <stdexcept> // Required for std::out_of_range and std::invalid_argument
 
 namespace bbsgs {
 
-    ecgroup::Bytes GroupPublicKey::to_bytes() const {
-        ecgroup::Bytes out;
-        out.reserve(4 * ecgroup::G1_SERIALIZED_SIZE + 2 * ecgroup::G2_SERIALIZED_SIZE);
-        auto append = [&](const ecgroup::Bytes& b) {
-            out.insert(out.end(), b.begin(), b.end());
-        };
-        append(g1.to_bytes());
-        append(h.to_bytes());
-        append(u.to_bytes());
-        append(v.to_bytes());
-        append(g2.to_bytes());
-        append(w.to_bytes());
+    ecgroup::Bytes GroupPublicKey::to_bytes(ecgroup::PointEncoding encoding) const {
+        ecgroup::Bytes out(serialized_size(encoding));
+        write_to(out.data(), encoding);
         return out;
     }
 
-    GroupPublicKey GroupPublicKey::from_bytes(const ecgroup::Bytes& b) {
+    void GroupPublicKey::write_to(uint8_t* out, ecgroup::PointEncoding encoding) const {
+        g1.write_to(out, encoding);
+        out += ecgroup::g1_size(encoding);
+        h.write_to(out, encoding);
+        out += ecgroup::g1_size(encoding);
+        u.write_to(out, encoding);
+        out += ecgroup::g1_size(encoding);
+        v.write_to(out, encoding);
+        out += ecgroup::g1_size(encoding);
+        g2.write_to(out, encoding);
+        out += ecgroup::g2_size(encoding);
+        w.write_to(out, encoding);
+    }
+
+    GroupPublicKey GroupPublicKey::from_bytes(const ecgroup::Bytes& b, ecgroup::PointEncoding encoding,
+                                              ecgroup::Validation validation) {
+        return read_from(b.data(), b.size(), encoding, validation);
+    }
+
+    GroupPublicKey GroupPublicKey::read_from(const uint8_t* in, size_t len, ecgroup::PointEncoding encoding,
+                                             ecgroup::Validation validation) {
+        if (len < serialized_size(encoding)) {
+            ecgroup::metrics::count(ecgroup::metrics::Counter::DecodeFailures);
+            throw std::out_of_range("Not enough bytes for GroupPublicKey deserialization.");
+        }
+
         GroupPublicKey gpk;
-        size_t offset = 0;
-        
-        auto slice = [&](size_t len) {
-            if (offset + len > b.size()) {
-                throw std::out_of_range("Not enough bytes for GroupPublicKey deserialization.");
-            }
-            ecgroup::Bytes sub(b.begin() + offset, b.begin() + offset + len);
-            offset += len;
-            return sub;
-        };
-
-        gpk.g1 = ecgroup::G1Point::from_bytes(slice(ecgroup::G1_SERIALIZED_SIZE));
-        gpk.h = ecgroup::G1Point::from_bytes(slice(ecgroup::G1_SERIALIZED_SIZE));
-        gpk.u = ecgroup::G1Point::from_bytes(slice(ecgroup::G1_SERIALIZED_SIZE));
-        gpk.v = ecgroup::G1Point::from_bytes(slice(ecgroup::G1_SERIALIZED_SIZE));
-        gpk.g2 = ecgroup::G2Point::from_bytes(slice(ecgroup::G2_SERIALIZED_SIZE));
-        gpk.w = ecgroup::G2Point::from_bytes(slice(ecgroup::G2_SERIALIZED_SIZE));
+        gpk.g1 = ecgroup::G1Point::read_from(in, ecgroup::g1_size(encoding), encoding, validation);
+        in += ecgroup::g1_size(encoding);
+        gpk.h = ecgroup::G1Point::read_from(in, ecgroup::g1_size(encoding), encoding, validation);
+        in += ecgroup::g1_size(encoding);
+        gpk.u = ecgroup::G1Point::read_from(in, ecgroup::g1_size(encoding), encoding, validation);
+        in += ecgroup::g1_size(encoding);
+        gpk.v = ecgroup::G1Point::read_from(in, ecgroup::g1_size(encoding), encoding, validation);
+        in += ecgroup::g1_size(encoding);
+        gpk.g2 = ecgroup::G2Point::read_from(in, ecgroup::g2_size(encoding), encoding, validation);
+        in += ecgroup::g2_size(encoding);
+        gpk.w = ecgroup::G2Point::read_from(in, ecgroup::g2_size(encoding), encoding, validation);
 
         return gpk;
     }
 
 
+    PreparedGroupPublicKey::PreparedGroupPublicKey(const GroupPublicKey& key, size_t window_bits)
+        : gpk(key),
+          g1(key.g1, window_bits),
+          h(key.h, window_bits),
+          u(key.u, window_bits),
+          v(key.v, window_bits),
+          g2(key.g2),
+          w(key.w) {}
+
+    size_t PreparedGroupPublicKey::table_size_bytes() const {
+        return g1.table_size_bytes() + h.table_size_bytes() + u.table_size_bytes() + v.table_size_bytes();
+    }
+
     ecgroup::Bytes OpenerSecretKey::to_bytes() const {
-        ecgroup::Bytes out;
-        out.reserve(2 * ecgroup::FR_SERIALIZED_SIZE);
-        auto append = [&](const ecgroup::Bytes& b) {
-            out.insert(out.end(), b.begin(), b.end());
-        };
-        append(xi1.to_bytes());
-        append(xi2.to_bytes());
+        ecgroup::Bytes out(SERIALIZED_SIZE);
+        write_to(out.data());
         return out;
     }
 
+    void OpenerSecretKey::write_to(uint8_t* out) const {
+        xi1.write_to(out);
+        out += ecgroup::FR_SERIALIZED_SIZE;
+        xi2.write_to(out);
+    }
+
     OpenerSecretKey OpenerSecretKey::from_bytes(const ecgroup::Bytes& b) {
-        OpenerSecretKey isk;
-        size_t offset = 0;
-        
-        auto slice = [&](size_t len) {
-            if (offset + len > b.size()) {
-                throw std::out_of_range("Not enough bytes for OpenerSecretKey deserialization.");
-            }
-            ecgroup::Bytes sub(b.begin() + offset, b.begin() + offset + len);
-            offset += len;
-            return sub;
-        };
+        return read_from(b.data(), b.size());
+    }
+
+    OpenerSecretKey OpenerSecretKey::read_from(const uint8_t* in, size_t len) {
+        if (len < SERIALIZED_SIZE) {
+            ecgroup::metrics::count(ecgroup::metrics::Counter::DecodeFailures);
+            throw std::out_of_range("Not enough bytes for OpenerSecretKey deserialization.");
+        }
 
-        isk.xi1 = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
-        isk.xi2 = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
+        OpenerSecretKey isk;
+        isk.xi1 = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
+        in += ecgroup::FR_SERIALIZED_SIZE;
+        isk.xi2 = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
 
         return isk;
     }
 
     ecgroup::Bytes IssuerSecretKey::to_bytes() const {
-        return gamma.to_bytes();
+        ecgroup::Bytes out(SERIALIZED_SIZE);
+        write_to(out.data());
+        return out;
+    }
+
+    void IssuerSecretKey::write_to(uint8_t* out) const {
+        gamma.write_to(out);
     }
 
     IssuerSecretKey IssuerSecretKey::from_bytes(const ecgroup::Bytes& b) {
+        return read_from(b.data(), b.size());
+    }
+
+    IssuerSecretKey IssuerSecretKey::read_from(const uint8_t* in, size_t len) {
+        if (len < SERIALIZED_SIZE) {
+            ecgroup::metrics::count(ecgroup::metrics::Counter::DecodeFailures);
+            throw std::out_of_range("Not enough bytes for IssuerSecretKey deserialization.");
+        }
+
         IssuerSecretKey ok;
-        ok.gamma = ecgroup::Scalar::from_bytes(b);
+        ok.gamma = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
+
         return ok;
     }
 
-    ecgroup::Bytes UserSecretKey::to_bytes() const {
-        ecgroup::Bytes out;
-        out.reserve(ecgroup::G1_SERIALIZED_SIZE + ecgroup::FR_SERIALIZED_SIZE);
-        auto append = [&](const ecgroup::Bytes& b) {
-            out.insert(out.end(), b.begin(), b.end());
-        };
-        append(A.to_bytes());
-        append(x.to_bytes());
+    ecgroup::Bytes UserSecretKey::to_bytes(ecgroup::PointEncoding encoding) const {
+        ecgroup::Bytes out(serialized_size(encoding));
+        write_to(out.data(), encoding);
         return out;
     }
 
-    UserSecretKey UserSecretKey::from_bytes(const ecgroup::Bytes& b) {
-        UserSecretKey usk;
-        size_t offset = 0;
-        
-        auto slice = [&](size_t len) {
-            if (offset + len > b.size()) {
-                throw std::out_of_range("Not enough bytes for UserSecretKey deserialization.");
-            }
-            ecgroup::Bytes sub(b.begin() + offset, b.begin() + offset + len);
-            offset += len;
-            return sub;
-        };
+    void UserSecretKey::write_to(uint8_t* out, ecgroup::PointEncoding encoding) const {
+        A.write_to(out, encoding);
+        out += ecgroup::g1_size(encoding);
+        x.write_to(out);
+    }
 
-        usk.A = ecgroup::G1Point::from_bytes(slice(ecgroup::G1_SERIALIZED_SIZE));
-        usk.x = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
+    UserSecretKey UserSecretKey::from_bytes(const ecgroup::Bytes& b, ecgroup::PointEncoding encoding,
+                                            ecgroup::Validation validation) {
+        return read_from(b.data(), b.size(), encoding, validation);
+    }
+
+    UserSecretKey UserSecretKey::read_from(const uint8_t* in, size_t len, ecgroup::PointEncoding encoding,
+                                           ecgroup::Validation validation) {
+        if (len < serialized_size(encoding)) {
+            ecgroup::metrics::count(ecgroup::metrics::Counter::DecodeFailures);
+            throw std::out_of_range("Not enough bytes for UserSecretKey deserialization.");
+        }
+
+        UserSecretKey usk;
+        usk.A = ecgroup::G1Point::read_from(in, ecgroup::g1_size(encoding), encoding, validation);
+        in += ecgroup::g1_size(encoding);
+        usk.x = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
 
         return usk;
     }
 
+    PreparedUserSigningKey::PreparedUserSigningKey(const UserSecretKey& key, const GroupPublicKey& gpk, size_t window_bits)
+        : usk(key),
+          e_A_g2(ecgroup::pairing(key.A, gpk.g2), window_bits),
+          e_h_g2(ecgroup::pairing(gpk.h, gpk.g2), window_bits),
+          e_h_w(ecgroup::pairing(gpk.h, gpk.w), window_bits) {}
+
+    PreparedUserSigningKey::~PreparedUserSigningKey() {
+        e_A_g2.wipe();
+        e_h_g2.wipe();
+        e_h_w.wipe();
+        ecgroup::secure_wipe(&usk.x, sizeof(usk.x));
+        ecgroup::secure_wipe(&usk.A, sizeof(usk.A));
+    }
+
+    size_t PreparedUserSigningKey::table_size_bytes() const {
+        return e_A_g2.table_size_bytes() + e_h_g2.table_size_bytes() + e_h_w.table_size_bytes();
+    }
+
     // --- New Implementation for GroupSignature ---
 
-    ecgroup::Bytes GroupSignature::to_bytes() const {
-        ecgroup::Bytes out;
-        // 3 G1 points and 6 Scalars, all 32 bytes each
-        out.reserve(9 * ecgroup::G1_SERIALIZED_SIZE); 
-        
-        auto append = [&](const ecgroup::Bytes& b) {
-            out.insert(out.end(), b.begin(), b.end());
-        };
-
-        // Append all components in a fixed, deterministic order
-        append(T1.to_bytes());
-        append(T2.to_bytes());
-        append(T3.to_bytes());
-        append(c.to_bytes());
-        append(s_alpha.to_bytes());
-        append(s_beta.to_bytes());
-        append(s_x.to_bytes());
-        append(s_delta_1.to_bytes());
-        append(s_delta_2.to_bytes());
-        
+    size_t GroupSignature::serialized_size(ecgroup::PointEncoding encoding) const {
+        size_t body = 3 * ecgroup::g1_size(encoding) + 6 * ecgroup::FR_SERIALIZED_SIZE;
+        return version == SignatureVersion::V1 ? body : body + 1;
+    }
+
+    ecgroup::Bytes GroupSignature::to_bytes(ecgroup::PointEncoding encoding) const {
+        ecgroup::Bytes out(serialized_size(encoding));
+        write_to(out.data(), encoding);
         return out;
     }
 
-    GroupSignature GroupSignature::from_bytes(const ecgroup::Bytes& b) {
-        GroupSignature sig;
-        size_t offset = 0;
+    void GroupSignature::write_to(uint8_t* out, ecgroup::PointEncoding encoding) const {
+        if (version != SignatureVersion::V1) {
+            *out++ = static_cast<uint8_t>(version);
+        }
+        T1.write_to(out, encoding);
+        out += ecgroup::g1_size(encoding);
+        T2.write_to(out, encoding);
+        out += ecgroup::g1_size(encoding);
+        T3.write_to(out, encoding);
+        out += ecgroup::g1_size(encoding);
+        c.write_to(out);
+        out += ecgroup::FR_SERIALIZED_SIZE;
+        s_alpha.write_to(out);
+        out += ecgroup::FR_SERIALIZED_SIZE;
+        s_beta.write_to(out);
+        out += ecgroup::FR_SERIALIZED_SIZE;
+        s_x.write_to(out);
+        out += ecgroup::FR_SERIALIZED_SIZE;
+        s_delta_1.write_to(out);
+        out += ecgroup::FR_SERIALIZED_SIZE;
+        s_delta_2.write_to(out);
+    }
 
-        auto slice = [&](size_t len) {
-            if (offset + len > b.size()) {
-                throw std::out_of_range("Not enough bytes for GroupSignature deserialization.");
+    void Presignature::wipe() {
+        for (ecgroup::Scalar* s : {&alpha, &beta, &r_alpha, &r_beta, &r_x, &r_delta_1, &r_delta_2}) {
+            ecgroup::secure_wipe(s, sizeof(*s));
+        }
+    }
+
+    GroupSignature GroupSignature::from_bytes(const ecgroup::Bytes& b, ecgroup::PointEncoding encoding,
+                                              ecgroup::Validation validation) {
+        return read_from(b.data(), b.size(), encoding, validation);
+    }
+
+    GroupSignature GroupSignature::read_from(const uint8_t* in, size_t len, ecgroup::PointEncoding encoding,
+                                             ecgroup::Validation validation) {
+        const size_t body = 3 * ecgroup::g1_size(encoding) + 6 * ecgroup::FR_SERIALIZED_SIZE;
+        if (len < body) {
+            ecgroup::metrics::count(ecgroup::metrics::Counter::DecodeFailures);
+            throw std::out_of_range("Not enough bytes for GroupSignature deserialization.");
+        }
+        if (len > body + 1) {
+            ecgroup::metrics::count(ecgroup::metrics::Counter::DecodeFailures);
+            throw std::invalid_argument("Trailing bytes after GroupSignature.");
+        }
+
+        GroupSignature sig;
+        if (len == body + 1) {
+            if (in[0] != static_cast<uint8_t>(SignatureVersion::V2)) {
+                ecgroup::metrics::count(ecgroup::metrics::Counter::DecodeFailures);
+                throw std::invalid_argument("Unknown GroupSignature version.");
             }
-            ecgroup::Bytes sub(b.begin() + offset, b.begin() + offset + len);
-            offset += len;
-            return sub;
-        };
-        
-        // Extract all components in the same order they were appended
-        sig.T1 = ecgroup::G1Point::from_bytes(slice(ecgroup::G1_SERIALIZED_SIZE));
-        sig.T2 = ecgroup::G1Point::from_bytes(slice(ecgroup::G1_SERIALIZED_SIZE));
-        sig.T3 = ecgroup::G1Point::from_bytes(slice(ecgroup::G1_SERIALIZED_SIZE));
-        sig.c = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
-        sig.s_alpha = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
-        sig.s_beta = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
-        sig.s_x = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
-        sig.s_delta_1 = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
-        sig.s_delta_2 = ecgroup::Scalar::from_bytes(slice(ecgroup::FR_SERIALIZED_SIZE));
+            sig.version = SignatureVersion::V2;
+            ++in;
+        }
+        sig.T1 = ecgroup::G1Point::read_from(in, ecgroup::g1_size(encoding), encoding, validation);
+        in += ecgroup::g1_size(encoding);
+        sig.T2 = ecgroup::G1Point::read_from(in, ecgroup::g1_size(encoding), encoding, validation);
+        in += ecgroup::g1_size(encoding);
+        sig.T3 = ecgroup::G1Point::read_from(in, ecgroup::g1_size(encoding), encoding, validation);
+        in += ecgroup::g1_size(encoding);
+        sig.c = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
+        in += ecgroup::FR_SERIALIZED_SIZE;
+        sig.s_alpha = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
+        in += ecgroup::FR_SERIALIZED_SIZE;
+        sig.s_beta = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
+        in += ecgroup::FR_SERIALIZED_SIZE;
+        sig.s_x = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
+        in += ecgroup::FR_SERIALIZED_SIZE;
+        sig.s_delta_1 = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
+        in += ecgroup::FR_SERIALIZED_SIZE;
+        sig.s_delta_2 = ecgroup::Scalar::read_from(in, ecgroup::FR_SERIALIZED_SIZE);
 
         return sig;
     }
@@ -16,31 +16,149 @@ namespace bbsgs {
         ecgroup::G1Point v;
         ecgroup::G2Point w;
 
-        ecgroup::Bytes to_bytes() const;
-        static GroupPublicKey from_bytes(const ecgroup::Bytes& b);
+        static constexpr size_t SERIALIZED_SIZE = 4 * ecgroup::G1_SERIALIZED_SIZE + 2 * ecgroup::G2_SERIALIZED_SIZE;
+
+        static constexpr size_t serialized_size(ecgroup::PointEncoding encoding) {
+            return 4 * ecgroup::g1_size(encoding) + 2 * ecgroup::g2_size(encoding);
+        }
+
+        ecgroup::Bytes to_bytes(ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed) const;
+        // Writes exactly serialized_size(encoding) bytes to out.
+        void write_to(uint8_t* out, ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed) const;
+        static GroupPublicKey from_bytes(const ecgroup::Bytes& b,
+                                         ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed,
+                                         ecgroup::Validation validation = ecgroup::Validation::Full);
+        // Reads serialized_size(encoding) bytes from in; throws std::out_of_range if len is shorter.
+        static GroupPublicKey read_from(const uint8_t* in, size_t len,
+                                        ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed,
+                                        ecgroup::Validation validation = ecgroup::Validation::Full);
+    };
+
+    /**
+     * A GroupPublicKey with fixed-base tables for its G1 generators and Miller-loop
+     * lines for g2 and w, built once and reused for every call against the same group.
+     * window_bits trades memory for speed: 4 bits is 960 points per base. Their size
+     * depends on the curve and on mcl's build width; table_size_bytes() reports it.
+     */
+    struct PreparedGroupPublicKey {
+        GroupPublicKey gpk;
+        ecgroup::G1FixedBase g1;
+        ecgroup::G1FixedBase h;
+        ecgroup::G1FixedBase u;
+        ecgroup::G1FixedBase v;
+        ecgroup::PreparedG2Point g2;
+        ecgroup::PreparedG2Point w;
+
+        explicit PreparedGroupPublicKey(const GroupPublicKey& gpk, size_t window_bits = 4);
+
+        size_t table_size_bytes() const;
     };
 
     struct OpenerSecretKey {
         ecgroup::Scalar xi1;
         ecgroup::Scalar xi2;
 
+        static constexpr size_t SERIALIZED_SIZE = 2 * ecgroup::FR_SERIALIZED_SIZE;
+
         ecgroup::Bytes to_bytes() const;
+        // Writes exactly SERIALIZED_SIZE bytes to out.
+        void write_to(uint8_t* out) const;
         static OpenerSecretKey from_bytes(const ecgroup::Bytes& b);
+        // Reads SERIALIZED_SIZE bytes from in; throws std::out_of_range if len is shorter.
+        static OpenerSecretKey read_from(const uint8_t* in, size_t len);
     };
 
     struct IssuerSecretKey {
         ecgroup::Scalar gamma;
 
+        static constexpr size_t SERIALIZED_SIZE = ecgroup::FR_SERIALIZED_SIZE;
+
         ecgroup::Bytes to_bytes() const;
+        // Writes exactly SERIALIZED_SIZE bytes to out.
+        void write_to(uint8_t* out) const;
         static IssuerSecretKey from_bytes(const ecgroup::Bytes& b);
+        // Reads SERIALIZED_SIZE bytes from in; throws std::out_of_range if len is shorter.
+        static IssuerSecretKey read_from(const uint8_t* in, size_t len);
     };
 
     struct UserSecretKey {
         ecgroup::G1Point A;
         ecgroup::Scalar x;
 
-        ecgroup::Bytes to_bytes() const;
-        static UserSecretKey from_bytes(const ecgroup::Bytes& b);
+        static constexpr size_t SERIALIZED_SIZE = ecgroup::G1_SERIALIZED_SIZE + ecgroup::FR_SERIALIZED_SIZE;
+
+        static constexpr size_t serialized_size(ecgroup::PointEncoding encoding) {
+            return ecgroup::g1_size(encoding) + ecgroup::FR_SERIALIZED_SIZE;
+        }
+
+        ecgroup::Bytes to_bytes(ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed) const;
+        // Writes exactly serialized_size(encoding) bytes to out.
+        void write_to(uint8_t* out, ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed) const;
+        static UserSecretKey from_bytes(const ecgroup::Bytes& b,
+                                        ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed,
+                                        ecgroup::Validation validation = ecgroup::Validation::Full);
+        // Reads serialized_size(encoding) bytes from in; throws std::out_of_range if len is shorter.
+        static UserSecretKey read_from(const uint8_t* in, size_t len,
+                                       ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed,
+                                       ecgroup::Validation validation = ecgroup::Validation::Full);
+    };
+
+    /**
+     * A UserSecretKey with GT tables for e(A, g2), e(h, g2) and e(h, w). Since
+     * T3 = A * h^(alpha+beta), the signing commitment R3 expands into powers of
+     * these three fixed elements, so signing needs no pairing at all.
+     * Only valid with the group key it was built from.
+     * At 4 window bits each table holds 960 GT elements, well over 1 MB for the three;
+     * table_size_bytes() gives the figure for this build. The tables derive from the
+     * secret A, so they are wiped on destruction and the key cannot be copied.
+     */
+    struct PreparedUserSigningKey {
+        UserSecretKey usk;
+        ecgroup::GTFixedBase e_A_g2;
+        ecgroup::GTFixedBase e_h_g2;
+        ecgroup::GTFixedBase e_h_w;
+
+        PreparedUserSigningKey(const UserSecretKey& usk, const GroupPublicKey& gpk, size_t window_bits = 4);
+        ~PreparedUserSigningKey();
+
+        PreparedUserSigningKey(const PreparedUserSigningKey&) = delete;
+        PreparedUserSigningKey& operator=(const PreparedUserSigningKey&) = delete;
+
+        size_t table_size_bytes() const;
+    };
+
+    struct Presignature {
+        ecgroup::Scalar alpha;
+        ecgroup::Scalar beta;
+        ecgroup::Scalar r_alpha;
+        ecgroup::Scalar r_beta;
+        ecgroup::Scalar r_x;
+        ecgroup::Scalar r_delta_1;
+        ecgroup::Scalar r_delta_2;
+        ecgroup::G1Point T1;
+        ecgroup::G1Point T2;
+        ecgroup::G1Point T3;
+        ecgroup::G1Point R1;
+        ecgroup::G1Point R2;
+        ecgroup::PairingResult R3;
+        ecgroup::G1Point R4;
+        ecgroup::G1Point R5;
+
+        // Zeroes alpha, beta and the nonces, the parts that reveal the signing key
+        // once the presignature has been finished for a message.
+        void wipe();
+    };
+
+    /**
+     * Wire and transcript format of a signature. V1 is the original unprefixed
+     * encoding (288 bytes on BN254) whose challenge hashes R3 as a full Fp12. V2
+     * prefixes the encoding with a version byte and hashes R3 torus-compressed,
+     * which halves that part of the transcript. Verifiers accept both, so fleets
+     * can switch signers over once every verifier understands V2.
+     */
+    enum class SignatureVersion : uint8_t {
+        V1 = 1,
+        V2 = 2,
     };
 
     struct GroupSignature {
@@ -53,9 +171,24 @@ namespace bbsgs {
         ecgroup::Scalar s_x;
         ecgroup::Scalar s_delta_1;
         ecgroup::Scalar s_delta_2;
+        SignatureVersion version = SignatureVersion::V1;
 
-        ecgroup::Bytes to_bytes() const;
-        static GroupSignature from_bytes(const ecgroup::Bytes& b);
+        // Size of a compressed V1 encoding; a V2 encoding is one version byte longer.
+        static constexpr size_t SERIALIZED_SIZE = 3 * ecgroup::G1_SERIALIZED_SIZE + 6 * ecgroup::FR_SERIALIZED_SIZE;
+
+        size_t serialized_size(ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed) const;
+        ecgroup::Bytes to_bytes(ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed) const;
+        // Writes exactly serialized_size(encoding) bytes to out.
+        void write_to(uint8_t* out, ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed) const;
+        static GroupSignature from_bytes(const ecgroup::Bytes& b,
+                                         ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed,
+                                         ecgroup::Validation validation = ecgroup::Validation::Full);
+        // len must be exactly the V1 size for the encoding (decoded as V1) or one byte
+        // more, starting with a known version byte. Throws std::out_of_range if len is
+        // too short and std::invalid_argument for any other length or an unknown version.
+        static GroupSignature read_from(const uint8_t* in, size_t len,
+                                        ecgroup::PointEncoding encoding = ecgroup::PointEncoding::Compressed,
+                                        ecgroup::Validation validation = ecgroup::Validation::Full);
     };
 
 } // namespace bbsgs
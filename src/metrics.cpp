@@ -0,0 +1,140 @@
+#include "metrics.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace ecgroup {
+namespace metrics {
+
+    namespace detail {
+        std::atomic<bool> enabled_flag{false};
+    } // namespace detail
+
+#if BBSGS_ENABLE_METRICS
+    namespace {
+
+        // One per thread. Only the owning thread adds to it, so the relaxed
+        // fetch_adds below never bounce a cache line between cores.
+        struct alignas(64) ThreadBlock {
+            std::atomic<uint64_t> counters[COUNTER_COUNT] = {};
+            std::atomic<uint64_t> op_count[OP_COUNT] = {};
+            std::atomic<uint64_t> op_latency_sum_ns[OP_COUNT] = {};
+            std::atomic<uint64_t> op_latency_buckets[OP_COUNT][LATENCY_BUCKETS] = {};
+        };
+
+        void accumulate(Snapshot& into, const ThreadBlock& b) {
+            for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+                into.counters[i] += b.counters[i].load(std::memory_order_relaxed);
+            }
+            for (size_t op = 0; op < OP_COUNT; ++op) {
+                into.op_count[op] += b.op_count[op].load(std::memory_order_relaxed);
+                into.op_latency_sum_ns[op] += b.op_latency_sum_ns[op].load(std::memory_order_relaxed);
+                for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+                    into.op_latency_buckets[op][i] += b.op_latency_buckets[op][i].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void clear(ThreadBlock& b) {
+            for (auto& c : b.counters) c.store(0, std::memory_order_relaxed);
+            for (size_t op = 0; op < OP_COUNT; ++op) {
+                b.op_count[op].store(0, std::memory_order_relaxed);
+                b.op_latency_sum_ns[op].store(0, std::memory_order_relaxed);
+                for (auto& c : b.op_latency_buckets[op]) c.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<ThreadBlock*> live;
+            Snapshot retired; // totals of threads that have exited
+        };
+
+        // Never destroyed: threads may still exit (and retire their block) during
+        // static destruction.
+        Registry& registry() {
+            static Registry* r = new Registry();
+            return *r;
+        }
+
+        struct ThreadSlot {
+            ThreadBlock block;
+
+            ThreadSlot() {
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                r.live.push_back(&block);
+            }
+
+            ~ThreadSlot() {
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                accumulate(r.retired, block);
+                r.live.erase(std::find(r.live.begin(), r.live.end(), &block));
+            }
+        };
+
+        ThreadBlock& local_block() {
+            thread_local ThreadSlot slot;
+            return slot.block;
+        }
+
+        size_t bucket_of(uint64_t ns) {
+            size_t b = 0;
+            while (ns >>= 1) {
+                ++b;
+            }
+            return std::min(b, LATENCY_BUCKETS - 1);
+        }
+
+    } // namespace
+
+    namespace detail {
+        void add(Counter c, uint64_t n) {
+            local_block().counters[static_cast<size_t>(c)].fetch_add(n, std::memory_order_relaxed);
+        }
+
+        void record(Op op, uint64_t ns) {
+            ThreadBlock& b = local_block();
+            size_t i = static_cast<size_t>(op);
+            b.op_count[i].fetch_add(1, std::memory_order_relaxed);
+            b.op_latency_sum_ns[i].fetch_add(ns, std::memory_order_relaxed);
+            b.op_latency_buckets[i][bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        }
+    } // namespace detail
+
+    void set_enabled(bool on) {
+        detail::enabled_flag.store(on, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        Snapshot s = r.retired;
+        for (const ThreadBlock* b : r.live) {
+            accumulate(s, *b);
+        }
+        return s;
+    }
+
+    void reset() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.retired = Snapshot();
+        for (ThreadBlock* b : r.live) {
+            clear(*b);
+        }
+    }
+#else
+    namespace detail {
+        void add(Counter, uint64_t) {}
+        void record(Op, uint64_t) {}
+    } // namespace detail
+
+    void set_enabled(bool) {}
+    Snapshot snapshot() { return Snapshot(); }
+    void reset() {}
+#endif
+
+} // namespace metrics
+} // namespace ecgroup
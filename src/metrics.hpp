@@ -0,0 +1,130 @@
+#ifndef SHIM_METRICS_HPP
+#define SHIM_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Set by the BBSGS_ENABLE_METRICS CMake option; without it every hook below is empty.
+#ifndef BBSGS_ENABLE_METRICS
+#define BBSGS_ENABLE_METRICS 0
+#endif
+
+namespace ecgroup {
+namespace metrics {
+
+    /**
+     * Operation counters and latency histograms for the hot paths of ecgroup and bbsgs.
+     *
+     * Collection is off until set_enabled(true). While off, each hook costs one relaxed
+     * atomic load and a predictable branch. While on, every thread updates its own
+     * cache-line-aligned block, so threads never contend; snapshot() sums the blocks of
+     * live threads and the totals left behind by threads that have exited.
+     */
+    enum class Counter : size_t {
+        Pairings,        // Miller loops, i.e. one per (G1, G2) pair of a multi-pairing
+        G1Muls,          // G1 scalar multiplications, fixed-base and multi-scalar included
+        G2Muls,
+        GTExps,          // GT exponentiations, fixed-base included
+        Hashes,          // hash-to-scalar and hash-to-curve digests
+        BytesHashed,
+        DecodeFailures,  // scalar, point, GT and key/signature decodes that threw
+        Count
+    };
+
+    enum class Op : size_t {
+        Sign,    // bbs04_sign and bbs04_sign_online
+        Verify,  // bbs04_verify, and each item of bbs04_verify_batch
+        Open,    // bbs04_open, and each item of bbs04_open_batch
+        Count
+    };
+
+    constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::Count);
+    constexpr size_t OP_COUNT = static_cast<size_t>(Op::Count);
+
+    // Bucket i counts calls that took [2^i, 2^(i+1)) ns; the last bucket also takes
+    // everything slower (2^31 ns is about 2.1 s).
+    constexpr size_t LATENCY_BUCKETS = 32;
+
+    constexpr bool COMPILED_IN = BBSGS_ENABLE_METRICS != 0;
+
+    struct Snapshot {
+        uint64_t counters[COUNTER_COUNT] = {};
+        uint64_t op_count[OP_COUNT] = {};
+        uint64_t op_latency_sum_ns[OP_COUNT] = {};
+        uint64_t op_latency_buckets[OP_COUNT][LATENCY_BUCKETS] = {};
+
+        uint64_t counter(Counter c) const { return counters[static_cast<size_t>(c)]; }
+        uint64_t count(Op op) const { return op_count[static_cast<size_t>(op)]; }
+    };
+
+    namespace detail {
+        extern std::atomic<bool> enabled_flag;
+        void add(Counter c, uint64_t n);
+        void record(Op op, uint64_t ns);
+    } // namespace detail
+
+    // Turning collection on has no effect when the library was built without metrics.
+    void set_enabled(bool on);
+    Snapshot snapshot();
+    // Zeroes every counter and histogram. Updates racing with a reset may survive it.
+    void reset();
+
+    inline bool enabled() {
+#if BBSGS_ENABLE_METRICS
+        return detail::enabled_flag.load(std::memory_order_relaxed);
+#else
+        return false;
+#endif
+    }
+
+    inline void count(Counter c, uint64_t n = 1) {
+#if BBSGS_ENABLE_METRICS
+        if (enabled()) {
+            detail::add(c, n);
+        }
+#else
+        (void)c;
+        (void)n;
+#endif
+    }
+
+    /**
+     * Records the lifetime of the enclosing scope in the histogram of op. Whether it
+     * records is decided at construction, so toggling collection mid-call is harmless.
+     */
+    class ScopedLatency {
+    public:
+#if BBSGS_ENABLE_METRICS
+        explicit ScopedLatency(Op op) : op(op), active(enabled()) {
+            if (active) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+        ~ScopedLatency() {
+            if (active) {
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                detail::record(op, static_cast<uint64_t>(ns));
+            }
+        }
+#else
+        explicit ScopedLatency(Op) {}
+#endif
+
+        ScopedLatency(const ScopedLatency&) = delete;
+        ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+#if BBSGS_ENABLE_METRICS
+    private:
+        Op op;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+#endif
+    };
+
+} // namespace metrics
+} // namespace ecgroup
+
+#endif // SHIM_METRICS_HPP
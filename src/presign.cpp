@@ -0,0 +1,121 @@
+#include "presign.hpp"
+
+namespace bbsgs {
+
+    PresignaturePool::PresignaturePool(const GroupPublicKey& gpk, const UserSecretKey& usk,
+                                       size_t capacity, size_t low_water_mark, size_t num_threads)
+        : pgpk(gpk),
+          pusk(usk, gpk),
+          queue(capacity),
+          low_water(low_water_mark),
+          refill_requested(true),
+          stopping(false),
+          refill_epoch(1),
+          produced(0),
+          consumed(0),
+          misses(0),
+          refills(0),
+          failures(0) {
+        if (num_threads == 0) {
+            num_threads = 1;
+        }
+        workers.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            workers.emplace_back(&PresignaturePool::worker_loop, this);
+        }
+    }
+
+    PresignaturePool::~PresignaturePool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping.store(true);
+        }
+        wake.notify_all();
+        for (auto& t : workers) {
+            t.join();
+        }
+    }
+
+    void PresignaturePool::worker_loop() {
+        uint64_t seen_epoch = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                wake.wait(lock, [&] { return stopping.load() || refill_epoch != seen_epoch; });
+                if (stopping.load()) {
+                    return;
+                }
+                seen_epoch = refill_epoch;
+                // Cleared before producing, so a request made during this refill starts another
+                refill_requested.store(false);
+            }
+
+            while (!stopping.load() && queue.size() < queue.capacity()) {
+                Presignature pre;
+                try {
+                    pre = bbs04_presign(pgpk, pusk);
+                } catch (...) {
+                    // Skip this round; the next low-water request retries
+                    failures.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                bool pushed = queue.try_push(std::move(pre));
+                // Moving mcl values copies them, so the local holds the nonces either way
+                pre.wipe();
+                if (!pushed) {
+                    break;
+                }
+                produced.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void PresignaturePool::request_refill() {
+        if (!refill_requested.exchange(true)) {
+            refills.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex);
+                ++refill_epoch;
+            }
+            wake.notify_all();
+        }
+    }
+
+    Presignature PresignaturePool::take() {
+        Presignature pre;
+        if (queue.try_pop(pre)) {
+            consumed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            Presignature fresh = bbs04_presign(pgpk, pusk);
+            pre = fresh;
+            fresh.wipe();
+        }
+        if (queue.size() <= low_water) {
+            request_refill();
+        }
+        return pre;
+    }
+
+    PresignaturePoolStats PresignaturePool::stats() const {
+        PresignaturePoolStats s;
+        s.depth = queue.size();
+        s.capacity = queue.capacity();
+        s.produced = produced.load(std::memory_order_relaxed);
+        s.consumed = consumed.load(std::memory_order_relaxed);
+        s.misses = misses.load(std::memory_order_relaxed);
+        s.refills = refills.load(std::memory_order_relaxed);
+        s.failures = failures.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    const UserSecretKey& PresignaturePool::get_usk() const {
+        return pusk.usk;
+    }
+
+    GroupSignature bbs04_sign_online(PresignaturePool& pool, ecgroup::Bytes const &message,
+                                     SignatureVersion version) {
+        return bbs04_sign_online(pool.take(), pool.get_usk(), message, version);
+    }
+
+} // namespace bbsgs
@@ -0,0 +1,78 @@
+#ifndef BBSGS_PRESIGN_HPP
+#define BBSGS_PRESIGN_HPP
+
+#include "bounded_queue.hpp"
+#include "signature.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bbsgs {
+
+    struct PresignaturePoolStats {
+        size_t depth;       // presignatures ready right now
+        size_t capacity;
+        uint64_t produced;  // presignatures computed by the background workers
+        uint64_t consumed;  // presignatures handed out by the pool
+        uint64_t misses;    // online signs that found the pool empty and signed inline
+        uint64_t refills;   // times the low-water mark woke the workers
+        uint64_t failures;  // background presignatures that threw and were skipped
+    };
+
+    /**
+     * Keeps a bounded stock of presignatures for one signer, computed on background
+     * threads with the pairing-free prepared keys. Consumers take from a lock-free
+     * queue; when the depth drops to the low-water mark the workers refill it to
+     * capacity. Each presignature leaves the queue exactly once.
+     */
+    class PresignaturePool {
+    public:
+        PresignaturePool(const GroupPublicKey& gpk, const UserSecretKey& usk,
+                         size_t capacity = 256, size_t low_water = 64, size_t num_threads = 1);
+        ~PresignaturePool();
+
+        PresignaturePool(const PresignaturePool&) = delete;
+        PresignaturePool& operator=(const PresignaturePool&) = delete;
+
+        // Pops a ready presignature; falls back to computing one inline when empty.
+        Presignature take();
+
+        PresignaturePoolStats stats() const;
+        const UserSecretKey& get_usk() const;
+
+    private:
+        void worker_loop();
+        void request_refill();
+
+        PreparedGroupPublicKey pgpk;
+        PreparedUserSigningKey pusk;
+        BoundedQueue<Presignature> queue;
+        const size_t low_water;
+
+        // Set by consumers without locking so the fast path stays lock-free; the first
+        // request of a refill also bumps refill_epoch under wake_mutex, which is what
+        // the workers wait on.
+        std::atomic<bool> refill_requested;
+        std::atomic<bool> stopping;
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        uint64_t refill_epoch;
+        std::vector<std::thread> workers;
+
+        std::atomic<uint64_t> produced;
+        std::atomic<uint64_t> consumed;
+        std::atomic<uint64_t> misses;
+        std::atomic<uint64_t> refills;
+        std::atomic<uint64_t> failures;
+    };
+
+    // Online signing: one hash and scalar arithmetic on top of a pooled presignature.
+    GroupSignature bbs04_sign_online(PresignaturePool& pool, ecgroup::Bytes const &message,
+                                     SignatureVersion version = SignatureVersion::V1);
+
+} // namespace bbsgs
+
+#endif // BBSGS_PRESIGN_HPP
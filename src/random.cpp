@@ -0,0 +1,262 @@
+#include "random.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+#include <unistd.h>
+#endif
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+namespace ecgroup {
+
+    void secure_wipe(void* p, size_t len) {
+        // Unlike memset, not removed by the optimizer when the memory is dead afterwards
+        volatile uint8_t* v = static_cast<volatile uint8_t*>(p);
+        while (len--) {
+            *v++ = 0;
+        }
+    }
+
+    namespace {
+        void os_entropy(uint8_t* out, size_t len) {
+#if defined(__linux__)
+            // The raw syscall also works on Android API levels whose libc lacks getrandom()
+            while (len > 0) {
+                long n = syscall(SYS_getrandom, out, len, 0);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::runtime_error("getrandom failed.");
+                }
+                out += n;
+                len -= static_cast<size_t>(n);
+            }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+            while (len > 0) {
+                size_t n = std::min<size_t>(len, 256);
+                if (getentropy(out, n) != 0) {
+                    throw std::runtime_error("getentropy failed.");
+                }
+                out += n;
+                len -= n;
+            }
+#else
+            std::random_device rd;
+            for (size_t i = 0; i < len; ++i) {
+                out[i] = static_cast<uint8_t>(rd());
+            }
+#endif
+        }
+
+        uint32_t load_le32(const uint8_t* p) {
+            return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+        }
+
+        uint32_t rotl(uint32_t x, int n) {
+            return (x << n) | (x >> (32 - n));
+        }
+
+        void quarter_round(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+            a += b; d ^= a; d = rotl(d, 16);
+            c += d; b ^= c; b = rotl(b, 12);
+            a += b; d ^= a; d = rotl(d, 8);
+            c += d; b ^= c; b = rotl(b, 7);
+        }
+
+        // --- Process-wide state behind random_bytes ---
+        std::atomic<RandomSource*> installed_source{nullptr};
+        std::atomic<uint64_t> fork_generation{0};
+        // Bumped by set/clear_random_seed; seeded and seed_value are published by it.
+        std::atomic<uint64_t> seed_epoch{0};
+        std::atomic<uint64_t> next_ordinal{0};
+        bool seeded = false;
+        uint64_t seed_value = 0;
+
+        struct ThreadGenerator {
+            ChaCha20Rng rng;
+            uint64_t epoch = 0;
+            uint64_t forks = fork_generation.load(std::memory_order_relaxed);
+        };
+
+        bool register_fork_handler() {
+#if !defined(_WIN32)
+            pthread_atfork(nullptr, nullptr, [] { fork_generation.fetch_add(1, std::memory_order_relaxed); });
+#endif
+            return true;
+        }
+
+        void rekey(ChaCha20Rng& rng) {
+            if (!seeded) {
+                rng.reseed();
+                return;
+            }
+            uint64_t ordinal = next_ordinal.fetch_add(1, std::memory_order_relaxed);
+            uint8_t seed[ChaCha20Rng::KEY_SIZE] = {};
+            for (size_t i = 0; i < 8; ++i) {
+                seed[i] = static_cast<uint8_t>(seed_value >> (8 * i));
+                seed[8 + i] = static_cast<uint8_t>(ordinal >> (8 * i));
+            }
+            rng.reseed(seed);
+        }
+
+        ChaCha20Rng& thread_generator() {
+            static const bool fork_handler_registered = register_fork_handler();
+            (void)fork_handler_registered;
+            thread_local ThreadGenerator state;
+
+            uint64_t epoch = seed_epoch.load(std::memory_order_acquire);
+            uint64_t forks = fork_generation.load(std::memory_order_relaxed);
+            if (epoch != state.epoch) {
+                state.epoch = epoch;
+                state.forks = forks;
+                rekey(state.rng);
+            } else if (forks != state.forks) {
+                // A child must not replay its parent's stream, unless asked to be deterministic
+                state.forks = forks;
+                if (!seeded) {
+                    state.rng.reseed();
+                }
+            }
+            return state.rng;
+        }
+    } // namespace
+
+    void chacha20_block(const uint32_t (&key)[8], uint32_t counter, const uint32_t (&nonce)[3], uint8_t (&out)[64]) {
+        const uint32_t input[16] = {
+            0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+            key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+            counter, nonce[0], nonce[1], nonce[2],
+        };
+        uint32_t x[16];
+        std::copy(input, input + 16, x);
+        for (int i = 0; i < 10; ++i) {
+            quarter_round(x[0], x[4], x[8], x[12]);
+            quarter_round(x[1], x[5], x[9], x[13]);
+            quarter_round(x[2], x[6], x[10], x[14]);
+            quarter_round(x[3], x[7], x[11], x[15]);
+            quarter_round(x[0], x[5], x[10], x[15]);
+            quarter_round(x[1], x[6], x[11], x[12]);
+            quarter_round(x[2], x[7], x[8], x[13]);
+            quarter_round(x[3], x[4], x[9], x[14]);
+        }
+        for (size_t i = 0; i < 16; ++i) {
+            uint32_t v = x[i] + input[i];
+            out[4 * i] = static_cast<uint8_t>(v);
+            out[4 * i + 1] = static_cast<uint8_t>(v >> 8);
+            out[4 * i + 2] = static_cast<uint8_t>(v >> 16);
+            out[4 * i + 3] = static_cast<uint8_t>(v >> 24);
+        }
+        secure_wipe(x, sizeof(x));
+    }
+
+    // --- ChaCha20Rng Implementation ---
+    ChaCha20Rng::ChaCha20Rng() {
+        reseed();
+    }
+
+    ChaCha20Rng::ChaCha20Rng(const uint8_t (&seed)[KEY_SIZE]) {
+        reseed(seed);
+    }
+
+    ChaCha20Rng::~ChaCha20Rng() {
+        secure_wipe(key, sizeof(key));
+        secure_wipe(buffer, sizeof(buffer));
+    }
+
+    void ChaCha20Rng::reseed() {
+        uint8_t seed[KEY_SIZE];
+        os_entropy(seed, sizeof(seed));
+        reseed(seed);
+        secure_wipe(seed, sizeof(seed));
+        from_os = true;
+    }
+
+    void ChaCha20Rng::reseed(const uint8_t (&seed)[KEY_SIZE]) {
+        for (size_t i = 0; i < 8; ++i) {
+            key[i] = load_le32(seed + 4 * i);
+        }
+        secure_wipe(buffer, sizeof(buffer));
+        available = 0;
+        since_reseed = 0;
+        from_os = false;
+    }
+
+    void ChaCha20Rng::refill() {
+        static const uint32_t nonce[3] = {0, 0, 0};
+        // Every refill runs under a fresh key, so the counter can restart at zero
+        for (size_t b = 0; b < BLOCKS; ++b) {
+            chacha20_block(key, static_cast<uint32_t>(b), nonce, *reinterpret_cast<uint8_t(*)[64]>(buffer + 64 * b));
+        }
+        for (size_t i = 0; i < 8; ++i) {
+            key[i] = load_le32(buffer + 4 * i);
+        }
+        secure_wipe(buffer, KEY_SIZE);
+        available = sizeof(buffer) - KEY_SIZE;
+    }
+
+    void ChaCha20Rng::fill(uint8_t* out, size_t len) {
+        if (from_os && since_reseed >= RESEED_INTERVAL) {
+            uint8_t fresh[KEY_SIZE];
+            os_entropy(fresh, sizeof(fresh));
+            for (size_t i = 0; i < 8; ++i) {
+                key[i] ^= load_le32(fresh + 4 * i);
+            }
+            secure_wipe(fresh, sizeof(fresh));
+            secure_wipe(buffer, sizeof(buffer));
+            available = 0;
+            since_reseed = 0;
+        }
+        since_reseed += len;
+        while (len > 0) {
+            if (available == 0) {
+                refill();
+            }
+            size_t n = std::min(len, available);
+            uint8_t* src = buffer + sizeof(buffer) - available;
+            std::memcpy(out, src, n);
+            secure_wipe(src, n);
+            out += n;
+            len -= n;
+            available -= n;
+        }
+    }
+
+    // --- Source selection ---
+    void random_bytes(uint8_t* out, size_t len) {
+        if (RandomSource* source = installed_source.load(std::memory_order_acquire)) {
+            source->fill(out, len);
+            return;
+        }
+        thread_generator().fill(out, len);
+    }
+
+    void set_random_source(RandomSource* source) {
+        installed_source.store(source, std::memory_order_release);
+    }
+
+    void set_random_seed(uint64_t seed) {
+        seeded = true;
+        seed_value = seed;
+        next_ordinal.store(0, std::memory_order_relaxed);
+        seed_epoch.fetch_add(1, std::memory_order_release);
+        // Claim the first stream for the calling thread
+        thread_generator();
+    }
+
+    void clear_random_seed() {
+        seeded = false;
+        seed_epoch.fetch_add(1, std::memory_order_release);
+    }
+
+} // namespace ecgroup
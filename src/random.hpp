@@ -0,0 +1,90 @@
+#ifndef SHIM_RANDOM_HPP
+#define SHIM_RANDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ecgroup {
+
+    /**
+     * Where the randomness behind every secret scalar comes from.
+     *
+     * By default each thread owns a ChaCha20Rng seeded from the operating system, so
+     * signing threads never share generator state. set_random_source() installs one
+     * source for all threads instead (an HSM, a test double); it is then called from
+     * every signing thread at once and must be thread-safe.
+     */
+    class RandomSource {
+    public:
+        virtual ~RandomSource() = default;
+        virtual void fill(uint8_t* out, size_t len) = 0;
+    };
+
+    /**
+     * ChaCha20 DRBG with fast key erasure: every refill produces a few blocks of
+     * keystream, the first 32 bytes of which replace the key, so earlier output cannot
+     * be recomputed from the current state. An OS-seeded generator also folds fresh
+     * OS entropy into its key every RESEED_INTERVAL bytes.
+     * One instance is not thread-safe.
+     */
+    class ChaCha20Rng : public RandomSource {
+    public:
+        static constexpr size_t KEY_SIZE = 32;
+        static constexpr uint64_t RESEED_INTERVAL = uint64_t(1) << 24;
+
+        // Seeded from the operating system.
+        ChaCha20Rng();
+        // Deterministic stream for tests and benchmarks; never for real keys.
+        explicit ChaCha20Rng(const uint8_t (&seed)[KEY_SIZE]);
+        ~ChaCha20Rng() override;
+
+        ChaCha20Rng(const ChaCha20Rng&) = delete;
+        ChaCha20Rng& operator=(const ChaCha20Rng&) = delete;
+
+        void fill(uint8_t* out, size_t len) override;
+
+        // Restarts the generator from the operating system or from seed.
+        void reseed();
+        void reseed(const uint8_t (&seed)[KEY_SIZE]);
+
+    private:
+        static constexpr size_t BLOCKS = 8;
+
+        uint32_t key[8];
+        uint8_t buffer[BLOCKS * 64];
+        size_t available = 0;
+        uint64_t since_reseed = 0;
+        bool from_os = true;
+
+        void refill();
+    };
+
+    // Zeroes len bytes at p; unlike memset or std::fill, the stores survive even when
+    // the memory is never read again.
+    void secure_wipe(void* p, size_t len);
+
+    // One ChaCha20 block (RFC 8439) for the given key, block counter and nonce.
+    void chacha20_block(const uint32_t (&key)[8], uint32_t counter, const uint32_t (&nonce)[3], uint8_t (&out)[64]);
+
+    // Fills out from the installed source, or else from the calling thread's generator.
+    // Thread generators reseed from the operating system after fork() in the child.
+    void random_bytes(uint8_t* out, size_t len);
+
+    // Installs source for every thread; nullptr restores the per-thread generators.
+    // The source is not owned and must outlive its installation.
+    void set_random_source(RandomSource* source);
+
+    /**
+     * Deterministic mode for reproducible tests and benchmarks: every thread's
+     * generator is rekeyed from seed and the order in which threads first draw after
+     * this call (the calling thread is first). A single-threaded run is therefore
+     * reproducible, and concurrent threads still get distinct streams. Seeded
+     * generators keep their stream across fork(). clear_random_seed() goes back to
+     * OS seeding. Neither call may race with draws on other threads.
+     */
+    void set_random_seed(uint64_t seed);
+    void clear_random_seed();
+
+} // namespace ecgroup
+
+#endif // SHIM_RANDOM_HPP
@@ -0,0 +1,210 @@
+#include "registry.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bbsgs {
+
+    namespace {
+        constexpr char REGISTRY_MAGIC[8] = {'B', 'B', 'S', 'G', 'S', 'R', 'E', 'G'};
+        constexpr uint32_t REGISTRY_VERSION = 1;
+
+        constexpr uint32_t SLOT_EMPTY = 0;
+        constexpr uint32_t SLOT_OCCUPIED = 1;
+
+        static_assert(std::atomic<uint32_t>::is_always_lock_free, "registry slots need address-free atomics");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "registry header needs address-free atomics");
+
+        size_t slots_for(size_t capacity) {
+            size_t n = 16;
+            while (n < 2 * capacity) {
+                n <<= 1;
+            }
+            return n;
+        }
+    } // namespace
+
+    struct MemberRegistry::Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t key_size;
+        uint64_t capacity;
+        uint64_t slot_count;
+        std::atomic<uint64_t> count;
+    };
+
+    struct MemberRegistry::Slot {
+        // Published last with release order; readers acquire it before touching the rest
+        std::atomic<uint32_t> state;
+        uint32_t reserved;
+        uint64_t member_id;
+        uint8_t key[ecgroup::G1_SERIALIZED_SIZE];
+    };
+
+    MemberRegistry::MemberRegistry(size_t capacity)
+        : mapping(nullptr), mapping_size(0), file_backed(false), header(nullptr), slots(nullptr) {
+        map(-1, capacity, true);
+    }
+
+    MemberRegistry::MemberRegistry(const std::string& path, size_t capacity)
+        : mapping(nullptr), mapping_size(0), file_backed(true), header(nullptr), slots(nullptr) {
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("MemberRegistry: cannot open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MemberRegistry: cannot stat " + path);
+        }
+
+        try {
+            if (st.st_size == 0) {
+                map(fd, capacity, true);
+            } else {
+                const uint64_t file_size = static_cast<uint64_t>(st.st_size);
+                if (file_size < sizeof(Header)) {
+                    throw std::runtime_error("MemberRegistry: " + path + " is truncated.");
+                }
+                // Read the stored capacity, then map the whole file
+                Header stored;
+                if (::pread(fd, &stored, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header)) ||
+                    std::memcmp(stored.magic, REGISTRY_MAGIC, sizeof(REGISTRY_MAGIC)) != 0 ||
+                    stored.version != REGISTRY_VERSION ||
+                    stored.key_size != ecgroup::G1_SERIALIZED_SIZE) {
+                    throw std::runtime_error("MemberRegistry: " + path + " is not a compatible registry.");
+                }
+                // Touching a mapping past the end of the file raises SIGBUS, so the slot
+                // array must fit; bounding capacity first also keeps slots_for from overflowing
+                const uint64_t max_slots = (file_size - sizeof(Header)) / sizeof(Slot);
+                if (stored.capacity > max_slots / 2 ||
+                    sizeof(Header) + slots_for(stored.capacity) * sizeof(Slot) > file_size) {
+                    throw std::runtime_error("MemberRegistry: " + path + " is truncated.");
+                }
+                map(fd, stored.capacity, false);
+            }
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+    }
+
+    MemberRegistry::~MemberRegistry() {
+        if (mapping != nullptr) {
+            if (file_backed) {
+                ::msync(mapping, mapping_size, MS_SYNC);
+            }
+            ::munmap(mapping, mapping_size);
+        }
+    }
+
+    void MemberRegistry::map(int fd, size_t capacity, bool initialize) {
+        if (capacity == 0) {
+            throw std::invalid_argument("MemberRegistry capacity must be positive.");
+        }
+        const size_t slot_count = slots_for(capacity);
+        mapping_size = sizeof(Header) + slot_count * sizeof(Slot);
+
+        if (fd >= 0 && initialize && ::ftruncate(fd, static_cast<off_t>(mapping_size)) != 0) {
+            throw std::runtime_error("MemberRegistry: cannot size the registry file.");
+        }
+
+        int flags = fd >= 0 ? MAP_SHARED : (MAP_PRIVATE | MAP_ANONYMOUS);
+        mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, flags, fd, 0);
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            throw std::runtime_error("MemberRegistry: mmap failed.");
+        }
+
+        header = static_cast<Header*>(mapping);
+        slots = reinterpret_cast<Slot*>(static_cast<uint8_t*>(mapping) + sizeof(Header));
+
+        // Fresh mappings are zero-filled, which is already the empty state for every slot
+        if (initialize) {
+            std::memcpy(header->magic, REGISTRY_MAGIC, sizeof(REGISTRY_MAGIC));
+            header->version = REGISTRY_VERSION;
+            header->key_size = ecgroup::G1_SERIALIZED_SIZE;
+            header->capacity = capacity;
+            header->slot_count = slot_count;
+            header->count.store(0, std::memory_order_relaxed);
+        } else if (header->slot_count != slot_count) {
+            ::munmap(mapping, mapping_size);
+            mapping = nullptr;
+            throw std::runtime_error("MemberRegistry: registry file is corrupt.");
+        }
+    }
+
+    size_t MemberRegistry::probe_start(const uint8_t* key) const {
+        // The compressed encoding is dominated by the x coordinate, which is already uniform;
+        // a splitmix finalizer over the first 8 bytes is plenty
+        uint64_t h;
+        std::memcpy(&h, key, sizeof(h));
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return static_cast<size_t>(h & (header->slot_count - 1));
+    }
+
+    bool MemberRegistry::add(const ecgroup::G1Point& A, uint64_t member_id) {
+        uint8_t key[ecgroup::G1_SERIALIZED_SIZE];
+        A.write_to(key);
+
+        std::lock_guard<std::mutex> lock(write_mutex);
+        const size_t mask = header->slot_count - 1;
+        for (size_t i = probe_start(key);; i = (i + 1) & mask) {
+            Slot& slot = slots[i];
+            if (slot.state.load(std::memory_order_relaxed) == SLOT_OCCUPIED) {
+                if (std::memcmp(slot.key, key, sizeof(slot.key)) == 0) {
+                    return false;
+                }
+                continue;
+            }
+            if (header->count.load(std::memory_order_relaxed) >= header->capacity) {
+                throw std::length_error("MemberRegistry is full.");
+            }
+            std::memcpy(slot.key, key, sizeof(slot.key));
+            slot.member_id = member_id;
+            slot.state.store(SLOT_OCCUPIED, std::memory_order_release);
+            header->count.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+    }
+
+    bool MemberRegistry::find(const ecgroup::G1Point& A, uint64_t& member_id) const {
+        uint8_t key[ecgroup::G1_SERIALIZED_SIZE];
+        A.write_to(key);
+
+        const size_t mask = header->slot_count - 1;
+        for (size_t i = probe_start(key);; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if (slot.state.load(std::memory_order_acquire) == SLOT_EMPTY) {
+                return false;
+            }
+            if (std::memcmp(slot.key, key, sizeof(slot.key)) == 0) {
+                member_id = slot.member_id;
+                return true;
+            }
+        }
+    }
+
+    size_t MemberRegistry::size() const {
+        return static_cast<size_t>(header->count.load(std::memory_order_acquire));
+    }
+
+    size_t MemberRegistry::capacity() const {
+        return static_cast<size_t>(header->capacity);
+    }
+
+    void MemberRegistry::flush() const {
+        if (file_backed) {
+            ::msync(mapping, mapping_size, MS_SYNC);
+        }
+    }
+
+} // namespace bbsgs
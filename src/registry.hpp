@@ -0,0 +1,59 @@
+#ifndef BBSGS_REGISTRY_HPP
+#define BBSGS_REGISTRY_HPP
+
+#include "ecgroup.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace bbsgs {
+
+    /**
+     * Index from an opened credential A to the member ID it was issued to, keyed by
+     * the canonical compressed encoding of A. Open addressing with linear probing over
+     * a fixed power-of-two slot array kept at most half full.
+     *
+     * The table lives in one mapping, either anonymous or backed by a file, so a
+     * registry written by the issuer can be reopened by the opener. add() serializes
+     * writers with a mutex; find() is lock-free and may run concurrently with add().
+     */
+    class MemberRegistry {
+    public:
+        // In-memory registry for up to capacity members.
+        explicit MemberRegistry(size_t capacity);
+        // Memory-mapped registry at path. An existing file is reopened with its own capacity.
+        MemberRegistry(const std::string& path, size_t capacity);
+        ~MemberRegistry();
+
+        MemberRegistry(const MemberRegistry&) = delete;
+        MemberRegistry& operator=(const MemberRegistry&) = delete;
+
+        // Records A -> member_id. Returns false if A is already registered;
+        // throws std::length_error when the registry is full.
+        bool add(const ecgroup::G1Point& A, uint64_t member_id);
+        bool find(const ecgroup::G1Point& A, uint64_t& member_id) const;
+
+        size_t size() const;
+        size_t capacity() const;
+        // Flushes a file-backed registry to disk; no-op for in-memory ones.
+        void flush() const;
+
+    private:
+        struct Header;
+        struct Slot;
+
+        void map(int fd, size_t capacity, bool initialize);
+        size_t probe_start(const uint8_t* key) const;
+
+        void* mapping;
+        size_t mapping_size;
+        bool file_backed;
+        Header* header;
+        Slot* slots;
+        std::mutex write_mutex;
+    };
+
+} // namespace bbsgs
+
+#endif // BBSGS_REGISTRY_HPP
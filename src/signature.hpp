@@ -7,16 +7,76 @@ namespace bbsgs {
 
     using namespace ecgroup;
 
-    GroupSignature bbs04_sign(GroupPublicKey const &gpk, UserSecretKey const &usk, ecgroup::Bytes const &message);
+    GroupSignature bbs04_sign(GroupPublicKey const &gpk, UserSecretKey const &usk, ecgroup::Bytes const &message,
+                              SignatureVersion version = SignatureVersion::V1);
+    // Signs message[0, message_len) in place, without copying it.
+    GroupSignature bbs04_sign(GroupPublicKey const &gpk, UserSecretKey const &usk,
+                              const uint8_t* message, size_t message_len,
+                              SignatureVersion version = SignatureVersion::V1);
+    GroupSignature bbs04_sign(PreparedGroupPublicKey const &pgpk, UserSecretKey const &usk, ecgroup::Bytes const &message,
+                              SignatureVersion version = SignatureVersion::V1);
+    // Pairing-free signing; pusk must have been prepared against the same group key.
+    GroupSignature bbs04_sign(GroupPublicKey const &gpk, PreparedUserSigningKey const &pusk, ecgroup::Bytes const &message,
+                              SignatureVersion version = SignatureVersion::V1);
+    GroupSignature bbs04_sign(PreparedGroupPublicKey const &pgpk, PreparedUserSigningKey const &pusk, ecgroup::Bytes const &message,
+                              SignatureVersion version = SignatureVersion::V1);
+    // Signs message[0, message_len) in place; with prepared keys this makes no heap allocation.
+    GroupSignature bbs04_sign(PreparedGroupPublicKey const &pgpk, PreparedUserSigningKey const &pusk,
+                              const uint8_t* message, size_t message_len,
+                              SignatureVersion version = SignatureVersion::V1);
+
+    /**
+     * Offline/online signing. A presignature holds everything in a signature that does
+     * not depend on the message. Finishing one for two different messages reveals the
+     * signing key, so every presignature must be consumed exactly once.
+     */
+    Presignature bbs04_presign(GroupPublicKey const &gpk, UserSecretKey const &usk);
+    Presignature bbs04_presign(PreparedGroupPublicKey const &pgpk, PreparedUserSigningKey const &pusk);
+    // Hashes the message and computes the five responses; no group operations.
+    // Consumes pre: its secret scalars are wiped before this returns.
+    GroupSignature bbs04_sign_online(Presignature &&pre, UserSecretKey const &usk, ecgroup::Bytes const &message,
+                                     SignatureVersion version = SignatureVersion::V1);
+
     bool bbs04_verify(GroupPublicKey const &gpk, ecgroup::Bytes const &message, GroupSignature const &sigma);
+    bool bbs04_verify(GroupPublicKey const &gpk, const uint8_t* message, size_t message_len,
+                      GroupSignature const &sigma);
+    bool bbs04_verify(PreparedGroupPublicKey const &pgpk, ecgroup::Bytes const &message, GroupSignature const &sigma);
+    // Verifies over message[0, message_len) in place, without heap allocation.
+    bool bbs04_verify(PreparedGroupPublicKey const &pgpk, const uint8_t* message, size_t message_len,
+                      GroupSignature const &sigma);
+    // Verifies messages[i]/sigmas[i] under gpk. Returns true iff every signature is valid;
+    // when results is non-null it receives one verdict per item. The GroupPublicKey
+    // overload builds no tables; callers verifying batches under the same group should
+    // keep a PreparedGroupPublicKey, whose four tables cost far more than a small batch.
+    bool bbs04_verify_batch(GroupPublicKey const &gpk,
+                            std::vector<ecgroup::Bytes> const &messages,
+                            std::vector<GroupSignature> const &sigmas,
+                            std::vector<bool> *results = nullptr);
+    bool bbs04_verify_batch(PreparedGroupPublicKey const &pgpk,
+                            std::vector<ecgroup::Bytes> const &messages,
+                            std::vector<GroupSignature> const &sigmas,
+                            std::vector<bool> *results = nullptr);
     ecgroup::G1Point bbs04_open(const GroupPublicKey& gpk, const OpenerSecretKey& osk, const GroupSignature& sigma);
+    // Opens every signature across num_threads workers (0 = one per core). Results are
+    // batch-normalized to affine form, so serializing them costs no field inversion.
+    // An exception in any worker is rethrown here once all workers have finished.
+    std::vector<ecgroup::G1Point> bbs04_open_batch(const GroupPublicKey& gpk, const OpenerSecretKey& osk,
+                                                   const std::vector<GroupSignature>& sigmas, size_t num_threads = 0);
     bool bbs04_verify_usk(const GroupPublicKey& gpk, const UserSecretKey& usk);
+    bool bbs04_verify_usk(const PreparedGroupPublicKey& pgpk, const UserSecretKey& usk);
 
     Scalar hash_all_to_scalar(
         const Bytes& message,
         const G1Point& T1, const G1Point& T2, const G1Point& T3,
         const G1Point& R1, const G1Point& R2, const PairingResult& R3,
-        const G1Point& R4, const G1Point& R5);
+        const G1Point& R4, const G1Point& R5,
+        SignatureVersion version = SignatureVersion::V1);
+    Scalar hash_all_to_scalar(
+        const uint8_t* message, size_t message_len,
+        const G1Point& T1, const G1Point& T2, const G1Point& T3,
+        const G1Point& R1, const G1Point& R2, const PairingResult& R3,
+        const G1Point& R4, const G1Point& R5,
+        SignatureVersion version = SignatureVersion::V1);
 
 } // namespace bbsgs
 
@@ -0,0 +1,106 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+
+namespace bbsgs {
+
+    namespace {
+        // Which pool and queue the current thread works for, so nested submits stay local
+        thread_local const WorkStealingPool* current_pool = nullptr;
+        thread_local size_t current_index = 0;
+    } // namespace
+
+    WorkStealingPool::WorkStealingPool(size_t num_threads) : next_queue(0), pending(0), stopping(false) {
+        if (num_threads == 0) {
+            num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        queues.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            queues.emplace_back(new WorkerQueue());
+        }
+        threads.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            threads.emplace_back(&WorkStealingPool::run, this, i);
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    void WorkStealingPool::submit(std::function<void()> task) {
+        size_t target = (current_pool == this)
+            ? current_index
+            : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+        // Count the task before it becomes visible so a sleeping worker can't miss it
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            ++pending;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+    size_t WorkStealingPool::size() const {
+        return threads.size();
+    }
+
+    bool WorkStealingPool::try_take(size_t self, std::function<void()>& task) {
+        {
+            WorkerQueue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (size_t k = 1; k < queues.size(); ++k) {
+            WorkerQueue& victim = *queues[(self + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingPool::run(size_t index) {
+        current_pool = this;
+        current_index = index;
+
+        for (;;) {
+            std::function<void()> task;
+            if (try_take(index, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    --pending;
+                }
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            if (stopping && pending == 0) {
+                return;
+            }
+            wake.wait(lock, [this] { return stopping || pending > 0; });
+            if (stopping && pending == 0) {
+                return;
+            }
+        }
+    }
+
+} // namespace bbsgs
@@ -0,0 +1,55 @@
+#ifndef BBSGS_THREAD_POOL_HPP
+#define BBSGS_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bbsgs {
+
+    /**
+     * Fixed-size work-stealing thread pool. Every worker owns a deque: it pops its own
+     * tasks LIFO for cache locality and steals FIFO from the others when it runs dry.
+     * Tasks submitted from a worker go to that worker's deque, external submissions are
+     * spread round-robin. Queued tasks still run when the pool is destroyed.
+     * Tasks must not throw.
+     */
+    class WorkStealingPool {
+    public:
+        // num_threads == 0 means one worker per hardware thread.
+        explicit WorkStealingPool(size_t num_threads = 0);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        void submit(std::function<void()> task);
+        size_t size() const;
+
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        bool try_take(size_t self, std::function<void()>& task);
+        void run(size_t index);
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> threads;
+        std::atomic<size_t> next_queue;
+
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        size_t pending;
+        bool stopping;
+    };
+
+} // namespace bbsgs
+
+#endif // BBSGS_THREAD_POOL_HPP
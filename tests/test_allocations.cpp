@@ -0,0 +1,229 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "arena.hpp"
+#include "bbsgs/bbsgs.hpp"
+#include "bbsgs/bbsgs_c.h"
+
+// Replaces the global allocator for the whole test binary so that heap traffic can
+// be measured per operation. Only the calling thread's allocations are counted.
+//
+// Every replaceable operator new is hooked. On glibc, malloc, calloc and realloc
+// are interposed as well (forwarding to glibc's own entry points), which also
+// catches C code and mcl's internal buffers; operator new then goes through the
+// malloc hook instead of counting itself. Sanitizers install their own malloc, so
+// the interposition is left out under them.
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#define BBSGS_SANITIZED 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define BBSGS_SANITIZED 1
+#endif
+#if defined(__GLIBC__) && !defined(BBSGS_SANITIZED)
+#define BBSGS_HOOK_MALLOC 1
+#else
+#define BBSGS_HOOK_MALLOC 0
+#endif
+
+namespace {
+    thread_local size_t thread_allocations = 0;
+
+    // Heap allocations made by the calling thread while running f.
+    template <class F>
+    size_t allocations_in(F&& f) {
+        size_t before = thread_allocations;
+        f();
+        return thread_allocations - before;
+    }
+
+    void* counted_new(size_t size) noexcept {
+#if !BBSGS_HOOK_MALLOC
+        ++thread_allocations;
+#endif
+        return std::malloc(size ? size : 1);
+    }
+
+    void* counted_aligned_new(size_t size, std::align_val_t align) noexcept {
+        // posix_memalign is not interposed, so aligned requests always count here
+        ++thread_allocations;
+        void* p = nullptr;
+        size_t alignment = std::max(static_cast<size_t>(align), sizeof(void*));
+        return posix_memalign(&p, alignment, size ? size : 1) == 0 ? p : nullptr;
+    }
+
+    void* or_throw(void* p) {
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+}
+
+#if BBSGS_HOOK_MALLOC
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t n, size_t size);
+    void* __libc_realloc(void* p, size_t size);
+    void __libc_free(void* p);
+
+    void* malloc(size_t size) {
+        ++thread_allocations;
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t n, size_t size) {
+        ++thread_allocations;
+        return __libc_calloc(n, size);
+    }
+
+    void* realloc(void* p, size_t size) {
+        ++thread_allocations;
+        return __libc_realloc(p, size);
+    }
+
+    void free(void* p) {
+        __libc_free(p);
+    }
+}
+#endif
+
+void* operator new(size_t size) { return or_throw(counted_new(size)); }
+void* operator new[](size_t size) { return or_throw(counted_new(size)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return counted_new(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return counted_new(size); }
+void* operator new(size_t size, std::align_val_t align) { return or_throw(counted_aligned_new(size, align)); }
+void* operator new[](size_t size, std::align_val_t align) { return or_throw(counted_aligned_new(size, align)); }
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return counted_aligned_new(size, align);
+}
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return counted_aligned_new(size, align);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+TEST_CASE("Heap Allocations per Operation", "[allocations]") {
+    ecgroup::init_pairing();
+
+    bbsgs::GroupPublicKey gpk;
+    bbsgs::OpenerSecretKey osk;
+    bbsgs::IssuerSecretKey isk;
+    bbsgs::bbs04_setup(gpk, osk, isk);
+    bbsgs::UserSecretKey usk = bbsgs::bbs04_user_keygen(isk, gpk);
+    bbsgs::PreparedGroupPublicKey pgpk(gpk);
+    bbsgs::PreparedUserSigningKey pusk(usk, gpk);
+    ecgroup::Bytes message = {'a', 'l', 'l', 'o', 'c'};
+
+    // Warm up: sizes the thread's scratch arena and any lazily built state
+    bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(pgpk, pusk, message);
+    bbsgs::bbs04_verify(pgpk, message, sigma);
+    bbsgs::bbs04_open(gpk, osk, sigma);
+
+    SECTION("Every allocation path is counted") {
+        struct alignas(64) Wide {
+            unsigned char bytes[64];
+        };
+        // Stored through a volatile pointer so the compiler cannot elide the new/delete pairs
+        static void* volatile escape;
+        REQUIRE(allocations_in([] { escape = new int(1); delete static_cast<int*>(escape); }) == 1);
+        REQUIRE(allocations_in([] { escape = new int[4]; delete[] static_cast<int*>(escape); }) == 1);
+        REQUIRE(allocations_in([] { escape = new (std::nothrow) int(1); delete static_cast<int*>(escape); }) == 1);
+        REQUIRE(allocations_in([] { escape = new Wide(); delete static_cast<Wide*>(escape); }) == 1);
+        REQUIRE(allocations_in([] { escape = new Wide[2]; delete[] static_cast<Wide*>(escape); }) == 1);
+#if BBSGS_HOOK_MALLOC
+        REQUIRE(allocations_in([] { escape = std::malloc(16); std::free(escape); }) == 1);
+        REQUIRE(allocations_in([] { escape = std::calloc(2, 8); std::free(escape); }) == 1);
+#endif
+    }
+
+    // Budgets for steady-state calls. Raising one of these is a regression.
+    SECTION("Prepared C++ paths allocate nothing") {
+        REQUIRE(allocations_in([&] { bbsgs::bbs04_sign(pgpk, pusk, message.data(), message.size()); }) == 0);
+        REQUIRE(allocations_in([&] { bbsgs::bbs04_verify(pgpk, message.data(), message.size(), sigma); }) == 0);
+        REQUIRE(allocations_in([&] { bbsgs::bbs04_verify(pgpk, message, sigma); }) == 0);
+        REQUIRE(allocations_in([&] { bbsgs::bbs04_open(gpk, osk, sigma); }) == 0);
+    }
+
+    SECTION("Handle-based C calls allocate nothing") {
+        ecgroup::Bytes gpk_bytes = gpk.to_bytes();
+        ecgroup::Bytes usk_bytes = usk.to_bytes();
+        ecgroup::Bytes osk_bytes = osk.to_bytes();
+        bbs04_gpk_handle* gpk_h = bbs04_gpk_handle_new(gpk_bytes.data(), gpk_bytes.size());
+        bbs04_usk_handle* usk_h = bbs04_usk_handle_new(gpk_h, usk_bytes.data(), usk_bytes.size());
+        bbs04_osk_handle* osk_h = bbs04_osk_handle_new(osk_bytes.data(), osk_bytes.size());
+
+        unsigned char sig[BBS04_SIGNATURE_SIZE];
+        unsigned char cred[BBS04_CREDENTIAL_SIZE];
+        REQUIRE(bbs04_sign_h_into(gpk_h, usk_h, message.data(), message.size(), sig, sizeof(sig)) == BBSGS_OK);
+
+        REQUIRE(allocations_in([&] {
+            bbs04_sign_h_into(gpk_h, usk_h, message.data(), message.size(), sig, sizeof(sig));
+        }) == 0);
+        REQUIRE(allocations_in([&] {
+            bbs04_verify_h(gpk_h, sig, sizeof(sig), message.data(), message.size());
+        }) == 0);
+        REQUIRE(allocations_in([&] {
+            bbs04_open_h_into(gpk_h, osk_h, sig, sizeof(sig), cred, sizeof(cred));
+        }) == 0);
+
+        size_t sig_len = sizeof(sig), msg_len = message.size();
+        unsigned char result;
+        REQUIRE(allocations_in([&] {
+            bbs04_verify_batch_h(gpk_h, 1, sig, &sig_len, message.data(), &msg_len, &result);
+        }) == 0);
+        REQUIRE(result == 1);
+
+        bbs04_osk_handle_free(osk_h);
+        bbs04_usk_handle_free(usk_h);
+        bbs04_gpk_handle_free(gpk_h);
+    }
+
+    SECTION("Scratch arena stops allocating once sized") {
+        std::vector<ecgroup::G1Point> points(2048, ecgroup::G1Point::get_random());
+        std::vector<ecgroup::Scalar> scalars(points.size(), ecgroup::Scalar::get_random());
+
+        // The first large call spills into overflow blocks; the arena then grows to fit
+        ecgroup::G1Point first = ecgroup::G1Point::multi_mul(points.data(), scalars.data(), points.size());
+        REQUIRE(ecgroup::ScratchArena::local().capacity() >= points.size() * sizeof(mcl::bn::G1));
+
+        ecgroup::G1Point second;
+        REQUIRE(allocations_in([&] {
+            second = ecgroup::G1Point::multi_mul(points.data(), scalars.data(), points.size());
+        }) == 0);
+        REQUIRE(first == second);
+    }
+
+    SECTION("Scratch arena retains at most its cap") {
+        ecgroup::ScratchArena& arena = ecgroup::ScratchArena::local();
+        {
+            ecgroup::ScratchArena::Scope scope;
+            arena.make_array<uint8_t>(2 * ecgroup::ScratchArena::MAX_RETAINED_CAPACITY);
+        }
+        REQUIRE(arena.capacity() == ecgroup::ScratchArena::MAX_RETAINED_CAPACITY);
+
+        // Oversized requests keep working after the cap is reached; their blocks are freed again
+        {
+            ecgroup::ScratchArena::Scope scope;
+            uint8_t* big = arena.make_array<uint8_t>(2 * ecgroup::ScratchArena::MAX_RETAINED_CAPACITY);
+            big[2 * ecgroup::ScratchArena::MAX_RETAINED_CAPACITY - 1] = 1;
+        }
+        REQUIRE(arena.capacity() == ecgroup::ScratchArena::MAX_RETAINED_CAPACITY);
+    }
+}
@@ -1,5 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "bbsgs/bbsgs.hpp"
@@ -34,6 +40,12 @@ TEST_CASE("BBS04 Group Signature Scheme", "[bbsgs]") {
         // Verify the signature
         bool is_valid = bbsgs::bbs04_verify(gpk, message, sigma);
         REQUIRE(is_valid == true);
+
+        // The buffer overloads sign and verify the same bytes
+        bbsgs::GroupSignature sigma_buf = bbsgs::bbs04_sign(gpk, usk, message.data(), message.size());
+        REQUIRE(bbsgs::bbs04_verify(gpk, message.data(), message.size(), sigma_buf));
+        REQUIRE(bbsgs::bbs04_verify(gpk, message, sigma_buf));
+        REQUIRE(bbsgs::bbs04_verify(gpk, message.data(), message.size(), sigma));
     }
     
     SECTION("Signature Opening (Tracing)") {
@@ -79,4 +91,270 @@ TEST_CASE("BBS04 Group Signature Scheme", "[bbsgs]") {
         tampered_sigma_s.s_alpha = ecgroup::Scalar::get_random();
         REQUIRE_FALSE(bbsgs::bbs04_verify(gpk, message, tampered_sigma_s));
     }
-}
\ No newline at end of file
+
+    SECTION("Batch Verification") {
+        std::vector<ecgroup::Bytes> messages;
+        std::vector<bbsgs::GroupSignature> sigmas;
+        for (int i = 0; i < 4; ++i) {
+            ecgroup::Bytes m = message;
+            m.push_back(static_cast<uint8_t>(i));
+            sigmas.push_back(bbsgs::bbs04_sign(gpk, usk, m));
+            messages.push_back(m);
+        }
+
+        std::vector<bool> results;
+        REQUIRE(bbsgs::bbs04_verify_batch(gpk, messages, sigmas, &results));
+        REQUIRE(results == std::vector<bool>{true, true, true, true});
+
+        // A single bad item fails the batch and is reported individually
+        sigmas[2].s_x = ecgroup::Scalar::get_random();
+        REQUIRE_FALSE(bbsgs::bbs04_verify_batch(gpk, messages, sigmas));
+        REQUIRE_FALSE(bbsgs::bbs04_verify_batch(gpk, messages, sigmas, &results));
+        REQUIRE(results == std::vector<bool>{true, true, false, true});
+
+        // An empty batch is trivially valid
+        REQUIRE(bbsgs::bbs04_verify_batch(gpk, {}, {}));
+    }
+
+    SECTION("Prepared Group Public Key") {
+        bbsgs::PreparedGroupPublicKey pgpk(gpk);
+        REQUIRE(pgpk.table_size_bytes() > 0);
+
+        // Prepared and plain paths must be interchangeable
+        bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(pgpk, usk, message);
+        REQUIRE(bbsgs::bbs04_verify(gpk, message, sigma));
+        REQUIRE(bbsgs::bbs04_verify(pgpk, message, sigma));
+        REQUIRE(bbsgs::bbs04_verify(pgpk, message, bbsgs::bbs04_sign(gpk, usk, message)));
+        REQUIRE_FALSE(bbsgs::bbs04_verify(pgpk, {'f', 'a', 'i', 'l'}, sigma));
+
+        bbsgs::UserSecretKey usk2 = bbsgs::bbs04_user_keygen(isk, pgpk);
+        REQUIRE(bbsgs::bbs04_verify_usk(gpk, usk2));
+        REQUIRE(bbsgs::bbs04_verify_usk(pgpk, usk2));
+
+        bbsgs::UserSecretKey bad_usk = usk2;
+        bad_usk.x = ecgroup::Scalar::get_random();
+        REQUIRE_FALSE(bbsgs::bbs04_verify_usk(gpk, bad_usk));
+        REQUIRE_FALSE(bbsgs::bbs04_verify_usk(pgpk, bad_usk));
+        REQUIRE(bbsgs::bbs04_open(gpk, osk, bbsgs::bbs04_sign(pgpk, usk2, message)) == usk2.A);
+    }
+
+    SECTION("Pairing-Free Signing") {
+        bbsgs::PreparedUserSigningKey pusk(usk, gpk);
+        bbsgs::PreparedGroupPublicKey pgpk(gpk);
+
+        bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk, pusk, message);
+        REQUIRE(bbsgs::bbs04_verify(gpk, message, sigma));
+        REQUIRE(bbsgs::bbs04_open(gpk, osk, sigma) == usk.A);
+
+        bbsgs::GroupSignature sigma_prepared = bbsgs::bbs04_sign(pgpk, pusk, message);
+        REQUIRE(bbsgs::bbs04_verify(pgpk, message, sigma_prepared));
+        REQUIRE_FALSE(bbsgs::bbs04_verify(gpk, {'f', 'a', 'i', 'l'}, sigma_prepared));
+    }
+
+    SECTION("Offline/Online Signing") {
+        // A presignature finished for a message is an ordinary signature
+        bbsgs::Presignature pre = bbsgs::bbs04_presign(gpk, usk);
+        bbsgs::GroupSignature sigma = bbsgs::bbs04_sign_online(std::move(pre), usk, message);
+        REQUIRE(bbsgs::bbs04_verify(gpk, message, sigma));
+        REQUIRE(bbsgs::bbs04_open(gpk, osk, sigma) == usk.A);
+
+        // Finishing consumes the presignature's secrets
+        REQUIRE(pre.alpha.is_zero());
+        REQUIRE(pre.r_x.is_zero());
+        REQUIRE(pre.r_delta_2.is_zero());
+
+        bbsgs::PresignaturePool pool(gpk, usk, 8, 2, 2);
+        const size_t num_signs = 12;
+        for (size_t i = 0; i < num_signs; ++i) {
+            bbsgs::GroupSignature pooled = bbsgs::bbs04_sign_online(pool, message);
+            REQUIRE(bbsgs::bbs04_verify(gpk, message, pooled));
+        }
+
+        // Every take is served exactly once, from the queue or inline
+        bbsgs::PresignaturePoolStats stats = pool.stats();
+        REQUIRE(stats.capacity == 8);
+        REQUIRE(stats.consumed + stats.misses == num_signs);
+        REQUIRE(stats.depth <= stats.capacity);
+
+        // The low-water request alone must bring the workers back; nothing polls.
+        // Only this thread consumes, so once depth is at the mark the last take asked for a refill.
+        do {
+            pool.take().wipe();
+        } while (pool.stats().depth > 2);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (pool.stats().depth < pool.stats().capacity && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        stats = pool.stats();
+        REQUIRE(stats.depth == stats.capacity);
+        REQUIRE(stats.failures == 0);
+    }
+
+    SECTION("Batch Opening") {
+        bbsgs::UserSecretKey usk2 = bbsgs::bbs04_user_keygen(isk, gpk);
+        std::vector<bbsgs::GroupSignature> sigmas;
+        for (int i = 0; i < 5; ++i) {
+            sigmas.push_back(bbsgs::bbs04_sign(gpk, (i % 2 == 0) ? usk : usk2, message));
+        }
+
+        for (size_t threads : {0, 1, 3, 16}) {
+            std::vector<ecgroup::G1Point> opened = bbsgs::bbs04_open_batch(gpk, osk, sigmas, threads);
+            REQUIRE(opened.size() == sigmas.size());
+            for (size_t i = 0; i < sigmas.size(); ++i) {
+                REQUIRE(opened[i] == ((i % 2 == 0) ? usk.A : usk2.A));
+                REQUIRE(opened[i] == bbsgs::bbs04_open(gpk, osk, sigmas[i]));
+            }
+        }
+
+        REQUIRE(bbsgs::bbs04_open_batch(gpk, osk, {}).empty());
+    }
+
+    SECTION("Batch User Key Generation") {
+        bbsgs::PreparedGroupPublicKey pgpk(gpk);
+        const size_t count = 2 * bbsgs::KEYGEN_CHUNK + 5;
+        std::vector<bbsgs::UserSecretKey> issued(count);
+        std::vector<bool> seen(count, false);
+        size_t duplicates = 0;
+        // The sink runs on worker threads, so it records instead of asserting
+        size_t n = bbsgs::bbs04_user_keygen_batch(isk, pgpk, count, [&](size_t index, bbsgs::UserSecretKey const &k) {
+            duplicates += seen[index] ? 1 : 0;
+            seen[index] = true;
+            issued[index] = k;
+            return true;
+        }, 3);
+        REQUIRE(n == count);
+        REQUIRE(duplicates == 0);
+        REQUIRE(std::find(seen.begin(), seen.end(), false) == seen.end());
+        for (size_t i = 0; i < count; i += 211) {
+            REQUIRE(bbsgs::bbs04_verify_usk(pgpk, issued[i]));
+        }
+        REQUIRE(bbsgs::bbs04_verify_usk(pgpk, issued.back()));
+        REQUIRE_FALSE(issued[0].x == issued[1].x);
+
+        // The sink can stop the batch, or abort it by throwing
+        REQUIRE(bbsgs::bbs04_user_keygen_batch(isk, pgpk, count, [](size_t, bbsgs::UserSecretKey const &) {
+            return false;
+        }, 2) == 1);
+        REQUIRE_THROWS_AS(bbsgs::bbs04_user_keygen_batch(isk, pgpk, count, [](size_t, bbsgs::UserSecretKey const &) -> bool {
+            throw std::runtime_error("sink failed");
+        }, 2), std::runtime_error);
+        REQUIRE(bbsgs::bbs04_user_keygen_batch(isk, pgpk, 0, [](size_t, bbsgs::UserSecretKey const &) { return true; }) == 0);
+    }
+
+    SECTION("Verify Engine") {
+        bbsgs::VerifyEngine engine(3);
+        REQUIRE(engine.num_threads() == 3);
+
+        ecgroup::Bytes wrong_message = {'w', 'r', 'o', 'n', 'g'};
+        std::vector<std::future<bool>> verified;
+        for (int i = 0; i < 20; ++i) {
+            bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk, usk, message);
+            verified.push_back(engine.verify(gpk, (i % 5 == 0) ? wrong_message : message, sigma));
+        }
+        for (size_t i = 0; i < verified.size(); ++i) {
+            REQUIRE(verified[i].get() == (i % 5 != 0));
+        }
+
+        std::promise<bool> callback_result;
+        engine.verify(gpk, message, bbsgs::bbs04_sign(gpk, usk, message),
+                      [&callback_result](bool ok) { callback_result.set_value(ok); });
+        REQUIRE(callback_result.get_future().get());
+
+        // A throwing callback is contained; the worker keeps serving later jobs
+        engine.verify(gpk, message, bbsgs::bbs04_sign(gpk, usk, message),
+                      [](bool) { throw std::runtime_error("callback failed"); });
+        REQUIRE(engine.verify(gpk, message, bbsgs::bbs04_sign(gpk, usk, message)).get());
+
+        // Keys beyond the cache limit evict older ones without affecting results
+        bbsgs::VerifyEngine small_cache(2, 1);
+        bbsgs::GroupPublicKey gpk2;
+        bbsgs::OpenerSecretKey osk2;
+        bbsgs::IssuerSecretKey isk2;
+        bbsgs::bbs04_setup(gpk2, osk2, isk2);
+        bbsgs::UserSecretKey usk2 = bbsgs::bbs04_user_keygen(isk2, gpk2);
+        for (int round = 0; round < 2; ++round) {
+            REQUIRE(small_cache.verify(gpk, message, bbsgs::bbs04_sign(gpk, usk, message)).get());
+            REQUIRE(small_cache.verify(gpk2, message, bbsgs::bbs04_sign(gpk2, usk2, message)).get());
+            REQUIRE_FALSE(small_cache.verify(gpk2, message, bbsgs::bbs04_sign(gpk, usk, message)).get());
+        }
+
+        bbsgs::GroupSignature signed_async = engine.sign(gpk, usk, message).get();
+        REQUIRE(bbsgs::bbs04_verify(gpk, message, signed_async));
+        REQUIRE(engine.open(gpk, osk, signed_async).get() == usk.A);
+    }
+
+    SECTION("Buffer Serialization") {
+        bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk, usk, message);
+        uint8_t buf[bbsgs::GroupSignature::SERIALIZED_SIZE];
+        sigma.write_to(buf);
+        REQUIRE(ecgroup::Bytes(buf, buf + sizeof(buf)) == sigma.to_bytes());
+
+        bbsgs::GroupSignature decoded = bbsgs::GroupSignature::read_from(buf, sizeof(buf));
+        REQUIRE(bbsgs::bbs04_verify(gpk, message, decoded));
+        REQUIRE_THROWS_AS(bbsgs::GroupSignature::read_from(buf, sizeof(buf) - 1), std::out_of_range);
+
+        ecgroup::Bytes gpk_bytes = gpk.to_bytes();
+        REQUIRE(gpk_bytes.size() == bbsgs::GroupPublicKey::SERIALIZED_SIZE);
+        REQUIRE(bbsgs::GroupPublicKey::read_from(gpk_bytes.data(), gpk_bytes.size()).to_bytes() == gpk_bytes);
+        ecgroup::Bytes usk_bytes = usk.to_bytes();
+        REQUIRE(bbsgs::UserSecretKey::read_from(usk_bytes.data(), usk_bytes.size()).to_bytes() == usk_bytes);
+        ecgroup::Bytes osk_bytes = osk.to_bytes();
+        REQUIRE(bbsgs::OpenerSecretKey::read_from(osk_bytes.data(), osk_bytes.size()).to_bytes() == osk_bytes);
+        ecgroup::Bytes isk_bytes = isk.to_bytes();
+        REQUIRE(bbsgs::IssuerSecretKey::read_from(isk_bytes.data(), isk_bytes.size()).to_bytes() == isk_bytes);
+    }
+
+    SECTION("Versioned Signatures") {
+        bbsgs::GroupSignature v2 = bbsgs::bbs04_sign(gpk, usk, message, bbsgs::SignatureVersion::V2);
+        REQUIRE(v2.version == bbsgs::SignatureVersion::V2);
+        REQUIRE(bbsgs::bbs04_verify(gpk, message, v2));
+
+        ecgroup::Bytes v2_bytes = v2.to_bytes();
+        REQUIRE(v2_bytes.size() == bbsgs::GroupSignature::SERIALIZED_SIZE + 1);
+        REQUIRE(v2_bytes[0] == 0x02);
+        bbsgs::GroupSignature decoded = bbsgs::GroupSignature::from_bytes(v2_bytes);
+        REQUIRE(decoded.version == bbsgs::SignatureVersion::V2);
+        REQUIRE(bbsgs::bbs04_verify(gpk, message, decoded));
+
+        // The version is bound into the challenge
+        decoded.version = bbsgs::SignatureVersion::V1;
+        REQUIRE_FALSE(bbsgs::bbs04_verify(gpk, message, decoded));
+
+        v2_bytes[0] = 0x07;
+        REQUIRE_THROWS_AS(bbsgs::GroupSignature::from_bytes(v2_bytes), std::invalid_argument);
+
+        // Only the V1 size and the V1 size plus a version byte are accepted
+        ecgroup::Bytes padded = v2.to_bytes();
+        padded.push_back(0);
+        REQUIRE_THROWS_AS(bbsgs::GroupSignature::from_bytes(padded), std::invalid_argument);
+
+        bbsgs::GroupSignature v1 = bbsgs::bbs04_sign(gpk, usk, message);
+        REQUIRE(v1.to_bytes().size() == bbsgs::GroupSignature::SERIALIZED_SIZE);
+        std::vector<bool> results;
+        REQUIRE(bbsgs::bbs04_verify_batch(gpk, {message, message}, {v1, v2}, &results));
+        REQUIRE(bbsgs::bbs04_open(gpk, osk, v2) == usk.A);
+    }
+
+    SECTION("Uncompressed Storage Encoding") {
+        const ecgroup::PointEncoding raw = ecgroup::PointEncoding::Uncompressed;
+
+        ecgroup::Bytes gpk_raw = gpk.to_bytes(raw);
+        REQUIRE(gpk_raw.size() == bbsgs::GroupPublicKey::serialized_size(raw));
+        bbsgs::GroupPublicKey gpk_loaded = bbsgs::GroupPublicKey::from_bytes(gpk_raw, raw);
+        REQUIRE(gpk_loaded.to_bytes() == gpk.to_bytes());
+
+        ecgroup::Bytes usk_raw = usk.to_bytes(raw);
+        REQUIRE(usk_raw.size() == bbsgs::UserSecretKey::serialized_size(raw));
+        REQUIRE(bbsgs::UserSecretKey::from_bytes(usk_raw, raw).to_bytes() == usk.to_bytes());
+
+        for (auto version : {bbsgs::SignatureVersion::V1, bbsgs::SignatureVersion::V2}) {
+            bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk, usk, message, version);
+            ecgroup::Bytes sig_raw = sigma.to_bytes(raw);
+            REQUIRE(sig_raw.size() == sigma.serialized_size(raw));
+            bbsgs::GroupSignature decoded = bbsgs::GroupSignature::from_bytes(sig_raw, raw);
+            REQUIRE(decoded.version == version);
+            REQUIRE(decoded.to_bytes() == sigma.to_bytes());
+            REQUIRE(bbsgs::bbs04_verify(gpk_loaded, message, decoded));
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "bbsgs/bbsgs_c.h"
+
+TEST_CASE("BBS04 C Interface", "[bbsgs_c]") {
+    bbs04_init_pairing();
+
+    unsigned char *gpk, *osk, *isk, *usk;
+    size_t gpk_len, osk_len, isk_len, usk_len;
+    REQUIRE(bbs04_setup_c(&gpk, &gpk_len, &osk, &osk_len, &isk, &isk_len) == BBSGS_OK);
+    REQUIRE(bbs04_user_keygen_c(gpk, gpk_len, isk, isk_len, &usk, &usk_len) == BBSGS_OK);
+
+    std::vector<unsigned char> message = {'s', 'a', 'm', 'p', 'l', 'e'};
+
+    SECTION("Curve") {
+        REQUIRE(std::string(bbs04_curve_name()) == BBSGS_CURVE_NAME);
+        REQUIRE(gpk_len == BBS04_GPK_SIZE);
+        REQUIRE(usk_len == BBS04_USK_SIZE);
+    }
+
+    SECTION("Key Handles") {
+        bbs04_gpk_handle* gpk_h = bbs04_gpk_handle_new(gpk, gpk_len);
+        REQUIRE(gpk_h != nullptr);
+        bbs04_usk_handle* usk_h = bbs04_usk_handle_new(gpk_h, usk, usk_len);
+        REQUIRE(usk_h != nullptr);
+        bbs04_osk_handle* osk_h = bbs04_osk_handle_new(osk, osk_len);
+        REQUIRE(osk_h != nullptr);
+
+        unsigned char* sig;
+        size_t sig_len;
+        REQUIRE(bbs04_sign_h(gpk_h, usk_h, message.data(), message.size(), &sig, &sig_len) == BBSGS_OK);
+        REQUIRE(bbs04_verify_h(gpk_h, sig, sig_len, message.data(), message.size()) == 1);
+        REQUIRE(bbs04_verify_h(gpk_h, sig, sig_len, message.data(), message.size() - 1) == 0);
+        REQUIRE(bbs04_verify_c(gpk, gpk_len, sig, sig_len, message.data(), message.size()) == 1);
+        REQUIRE(bbs04_verify_h(gpk_h, sig, sig_len - 1, message.data(), message.size()) == 0);
+        REQUIRE(bbs04_verify_h(nullptr, sig, sig_len, message.data(), message.size()) == 0);
+
+        unsigned char *opened_h, *opened_c;
+        size_t opened_h_len, opened_c_len;
+        REQUIRE(bbs04_open_h(gpk_h, osk_h, sig, sig_len, &opened_h, &opened_h_len) == BBSGS_OK);
+        REQUIRE(bbs04_open_c(gpk, gpk_len, osk, osk_len, sig, sig_len, &opened_c, &opened_c_len) == BBSGS_OK);
+        REQUIRE(std::vector<unsigned char>(opened_h, opened_h + opened_h_len) ==
+                std::vector<unsigned char>(opened_c, opened_c + opened_c_len));
+
+        REQUIRE(bbs04_gpk_handle_new(gpk, gpk_len - 1) == nullptr);
+        REQUIRE(bbs04_usk_handle_new(nullptr, usk, usk_len) == nullptr);
+
+        free_byte_buffer(opened_h);
+        free_byte_buffer(opened_c);
+        free_byte_buffer(sig);
+        bbs04_osk_handle_free(osk_h);
+        bbs04_usk_handle_free(usk_h);
+        bbs04_gpk_handle_free(gpk_h);
+    }
+
+    SECTION("Caller-Provided Buffers") {
+        unsigned char gpk2[BBS04_GPK_SIZE], osk2[BBS04_OSK_SIZE], isk2[BBS04_ISK_SIZE];
+        REQUIRE(bbs04_setup_into(gpk2, sizeof(gpk2), osk2, sizeof(osk2), isk2, sizeof(isk2)) == BBSGS_OK);
+
+        unsigned char usk2[BBS04_USK_SIZE];
+        REQUIRE(bbs04_user_keygen_into(gpk2, sizeof(gpk2), isk2, sizeof(isk2), usk2, sizeof(usk2) - 1) == BBSGS_ERR);
+        REQUIRE(bbs04_user_keygen_into(gpk2, sizeof(gpk2), isk2, sizeof(isk2), usk2, sizeof(usk2)) == BBSGS_OK);
+        REQUIRE(bbs04_verify_usk_c(gpk2, sizeof(gpk2), usk2, sizeof(usk2)) == 1);
+
+        unsigned char sig[BBS04_SIGNATURE_SIZE];
+        REQUIRE(bbs04_sign_into(gpk2, sizeof(gpk2), usk2, sizeof(usk2), message.data(), message.size(), sig, sizeof(sig)) == BBSGS_OK);
+        REQUIRE(bbs04_verify_c(gpk2, sizeof(gpk2), sig, sizeof(sig), message.data(), message.size()) == 1);
+        REQUIRE(bbs04_verify_c(gpk2, sizeof(gpk2), sig, sizeof(sig) - 1, message.data(), message.size()) == 0);
+        REQUIRE(bbs04_verify_usk_c(gpk2, sizeof(gpk2) - 1, usk2, sizeof(usk2)) == 0);
+
+        unsigned char opened[BBS04_CREDENTIAL_SIZE];
+        REQUIRE(bbs04_open_into(gpk2, sizeof(gpk2), osk2, sizeof(osk2), sig, sizeof(sig), opened, sizeof(opened)) == BBSGS_OK);
+        REQUIRE(std::vector<unsigned char>(opened, opened + sizeof(opened)) ==
+                std::vector<unsigned char>(usk2, usk2 + BBS04_G1_SIZE));
+
+        bbs04_gpk_handle* gpk_h = bbs04_gpk_handle_new(gpk2, sizeof(gpk2));
+        bbs04_usk_handle* usk_h = bbs04_usk_handle_new(gpk_h, usk2, sizeof(usk2));
+        bbs04_osk_handle* osk_h = bbs04_osk_handle_new(osk2, sizeof(osk2));
+        REQUIRE(bbs04_sign_h_into(gpk_h, usk_h, message.data(), message.size(), sig, sizeof(sig)) == BBSGS_OK);
+        REQUIRE(bbs04_verify_h(gpk_h, sig, sizeof(sig), message.data(), message.size()) == 1);
+        REQUIRE(bbs04_open_h_into(gpk_h, osk_h, sig, sizeof(sig), opened, sizeof(opened)) == BBSGS_OK);
+        REQUIRE(std::vector<unsigned char>(opened, opened + sizeof(opened)) ==
+                std::vector<unsigned char>(usk2, usk2 + BBS04_G1_SIZE));
+
+        unsigned char sig_v2[BBS04_SIGNATURE_V2_SIZE];
+        REQUIRE(bbs04_sign_h_into_v2(gpk_h, usk_h, message.data(), message.size(), sig_v2, sizeof(sig)) == BBSGS_ERR);
+        REQUIRE(bbs04_sign_h_into_v2(gpk_h, usk_h, message.data(), message.size(), sig_v2, sizeof(sig_v2)) == BBSGS_OK);
+        REQUIRE(sig_v2[0] == 0x02);
+        REQUIRE(bbs04_verify_h(gpk_h, sig_v2, sizeof(sig_v2), message.data(), message.size()) == 1);
+        REQUIRE(bbs04_verify_c(gpk2, sizeof(gpk2), sig_v2, sizeof(sig_v2), message.data(), message.size()) == 1);
+        REQUIRE(bbs04_open_h_into(gpk_h, osk_h, sig_v2, sizeof(sig_v2), opened, sizeof(opened)) == BBSGS_OK);
+        REQUIRE(std::vector<unsigned char>(opened, opened + sizeof(opened)) ==
+                std::vector<unsigned char>(usk2, usk2 + BBS04_G1_SIZE));
+        bbs04_osk_handle_free(osk_h);
+        bbs04_usk_handle_free(usk_h);
+        bbs04_gpk_handle_free(gpk_h);
+    }
+
+    SECTION("Batched Calls") {
+        bbs04_gpk_handle* gpk_h = bbs04_gpk_handle_new(gpk, gpk_len);
+        bbs04_usk_handle* usk_h = bbs04_usk_handle_new(gpk_h, usk, usk_len);
+
+        const size_t count = 4;
+        std::vector<unsigned char> msgs = {'a', 'b', 'b', 'c', 'c', 'c'};
+        std::vector<size_t> msg_lens = {1, 2, 3, 0};
+        std::vector<unsigned char> sigs(count * BBS04_SIGNATURE_SIZE);
+        REQUIRE(bbs04_sign_batch_h(gpk_h, usk_h, count, msgs.data(), msg_lens.data(), sigs.data(), sigs.size() - 1) == BBSGS_ERR);
+        REQUIRE(bbs04_sign_batch_h(gpk_h, usk_h, count, msgs.data(), msg_lens.data(), sigs.data(), sigs.size()) == BBSGS_OK);
+
+        std::vector<size_t> sig_lens(count, BBS04_SIGNATURE_SIZE);
+        std::vector<unsigned char> results(count);
+        REQUIRE(bbs04_verify_batch_h(gpk_h, count, sigs.data(), sig_lens.data(), msgs.data(), msg_lens.data(), results.data()) == 1);
+        REQUIRE(results == std::vector<unsigned char>(count, 1));
+
+        // A wrong message and a truncated signature fail only their own slots
+        msgs[0] = 'z';
+        sig_lens[3] = BBS04_SIGNATURE_SIZE - 1;
+        REQUIRE(bbs04_verify_batch_h(gpk_h, count, sigs.data(), sig_lens.data(), msgs.data(), msg_lens.data(), results.data()) == 0);
+        REQUIRE(results == std::vector<unsigned char>{0, 1, 1, 0});
+
+        // Bulk issuance streams keys through a callback
+        std::vector<std::vector<unsigned char>> keys(5);
+        bbs04_usk_sink collect = [](void* ctx, size_t index, const unsigned char* k, size_t len) {
+            (*static_cast<std::vector<std::vector<unsigned char>>*>(ctx))[index].assign(k, k + len);
+            return 0;
+        };
+        REQUIRE(bbs04_user_keygen_batch(gpk_h, isk, isk_len, keys.size(), 2, collect, &keys) == BBSGS_OK);
+        for (const auto& k : keys) {
+            REQUIRE(k.size() == BBS04_USK_SIZE);
+            REQUIRE(bbs04_verify_usk_c(gpk, gpk_len, k.data(), k.size()) == 1);
+        }
+        bbs04_usk_sink stop = [](void*, size_t, const unsigned char*, size_t) { return 1; };
+        REQUIRE(bbs04_user_keygen_batch(gpk_h, isk, isk_len, keys.size(), 2, stop, nullptr) == BBSGS_STOPPED);
+        REQUIRE(bbs04_user_keygen_batch(gpk_h, isk, isk_len - 1, keys.size(), 2, stop, nullptr) == BBSGS_ERR);
+
+        bbs04_usk_handle_free(usk_h);
+        bbs04_gpk_handle_free(gpk_h);
+    }
+
+    SECTION("Metrics") {
+        bbs04_metrics m;
+        if (bbs04_metrics_set_enabled(1) != BBSGS_OK) {
+            // Built without BBSGS_ENABLE_METRICS: everything reads as zero
+            REQUIRE(bbs04_metrics_snapshot(&m) == BBSGS_OK);
+            REQUIRE(m.op_count[BBS04_OP_SIGN] == 0);
+        } else {
+            bbs04_metrics_reset();
+
+            bbs04_gpk_handle* gpk_h = bbs04_gpk_handle_new(gpk, gpk_len);
+            bbs04_usk_handle* usk_h = bbs04_usk_handle_new(gpk_h, usk, usk_len);
+            unsigned char sig[BBS04_SIGNATURE_SIZE];
+            REQUIRE(bbs04_sign_h_into(gpk_h, usk_h, message.data(), message.size(), sig, sizeof(sig)) == BBSGS_OK);
+            REQUIRE(bbs04_verify_h(gpk_h, sig, sizeof(sig), message.data(), message.size()) == 1);
+            REQUIRE(bbs04_verify_h(gpk_h, sig, sizeof(sig) - 1, message.data(), message.size()) == 0);
+
+            REQUIRE(bbs04_metrics_snapshot(&m) == BBSGS_OK);
+            REQUIRE(m.op_count[BBS04_OP_SIGN] == 1);
+            REQUIRE(m.op_count[BBS04_OP_VERIFY] == 1);
+            REQUIRE(m.op_count[BBS04_OP_OPEN] == 0);
+            REQUIRE(m.counters[BBS04_METRIC_PAIRINGS] >= 2);
+            REQUIRE(m.counters[BBS04_METRIC_HASHES] >= 2);
+            REQUIRE(m.counters[BBS04_METRIC_DECODE_FAILURES] == 1);
+            uint64_t bucketed = 0;
+            for (size_t i = 0; i < BBS04_LATENCY_BUCKETS; ++i) {
+                bucketed += m.op_latency_buckets[BBS04_OP_VERIFY][i];
+            }
+            REQUIRE(bucketed == 1);
+            REQUIRE(m.op_latency_sum_ns[BBS04_OP_VERIFY] > 0);
+
+            // Disabled collection leaves the totals alone
+            REQUIRE(bbs04_metrics_set_enabled(0) == BBSGS_OK);
+            REQUIRE(bbs04_verify_h(gpk_h, sig, sizeof(sig), message.data(), message.size()) == 1);
+            bbs04_metrics after;
+            REQUIRE(bbs04_metrics_snapshot(&after) == BBSGS_OK);
+            REQUIRE(after.op_count[BBS04_OP_VERIFY] == 1);
+
+            bbs04_metrics_reset();
+            REQUIRE(bbs04_metrics_snapshot(&after) == BBSGS_OK);
+            REQUIRE(after.counters[BBS04_METRIC_PAIRINGS] == 0);
+
+            bbs04_usk_handle_free(usk_h);
+            bbs04_gpk_handle_free(gpk_h);
+        }
+    }
+
+    free_byte_buffer(gpk);
+    free_byte_buffer(osk);
+    free_byte_buffer(isk);
+    free_byte_buffer(usk);
+}
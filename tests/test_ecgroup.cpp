@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
 #include "ecgroup.hpp"
 
 // A single test case with sections for better organization.
@@ -24,6 +27,19 @@ TEST_CASE("Elliptic Curve Group Operations", "[ecgroup]") {
         ecgroup::Scalar s_inv_inv = s_inv.inverse();
         REQUIRE(s1 == s_inv_inv); // s == (s^-1)^-1
 
+        // Batch inversion agrees with one inversion per element
+        std::vector<ecgroup::Scalar> batch(9);
+        ecgroup::Scalar::fill_random(batch.data(), batch.size());
+        std::vector<ecgroup::Scalar> inverted = batch;
+        ecgroup::Scalar::batch_inverse(inverted.data(), inverted.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            REQUIRE(inverted[i] == batch[i].inverse());
+        }
+        std::vector<ecgroup::Scalar> with_zero = batch;
+        with_zero[4] = ecgroup::Scalar::add(batch[4], batch[4].negate());
+        REQUIRE(with_zero[4].is_zero());
+        REQUIRE_THROWS_AS(ecgroup::Scalar::batch_inverse(with_zero.data(), with_zero.size()), std::invalid_argument);
+
         // Test hashing to scalar
         ecgroup::Scalar h1 = ecgroup::Scalar::hash_to_scalar("test message");
         ecgroup::Scalar h2 = ecgroup::Scalar::hash_to_scalar("test message");
@@ -60,6 +76,45 @@ TEST_CASE("Elliptic Curve Group Operations", "[ecgroup]") {
         REQUIRE_FALSE(r1 == identity);
     }
 
+    SECTION("G1 multi-scalar multiplication") {
+        std::vector<ecgroup::G1Point> points;
+        std::vector<ecgroup::Scalar> scalars;
+        ecgroup::G1Point expected;
+
+        // Cover both the small interleaved path and the bucketed large-input path
+        for (size_t n : {1, 2, 3, 64}) {
+            points.clear();
+            scalars.clear();
+            for (size_t i = 0; i < n; ++i) {
+                points.push_back(ecgroup::G1Point::get_random());
+                scalars.push_back(ecgroup::Scalar::get_random());
+                ecgroup::G1Point term = ecgroup::G1Point::mul(points[i], scalars[i]);
+                expected = (i == 0) ? term : expected.add(term);
+            }
+            REQUIRE(ecgroup::G1Point::multi_mul(points, scalars) == expected);
+        }
+
+        REQUIRE(ecgroup::G1Point::multi_mul({}, {}) == ecgroup::G1Point());
+        REQUIRE_THROWS(ecgroup::G1Point::multi_mul(points, {}));
+    }
+
+    SECTION("G1 fixed-base tables") {
+        ecgroup::G1Point base = ecgroup::G1Point::get_random();
+        ecgroup::Scalar s = ecgroup::Scalar::get_random();
+        ecgroup::Scalar zero = s + s.negate();
+
+        for (size_t w : {1, 3, 4, 8}) {
+            ecgroup::G1FixedBase table(base, w);
+            REQUIRE(table.get_window_bits() == w);
+            REQUIRE(table.mul(s) == ecgroup::G1Point::mul(base, s));
+            REQUIRE(table.mul(s.negate()) == ecgroup::G1Point::mul(base, s.negate()));
+            REQUIRE(table.mul(zero) == ecgroup::G1Point());
+        }
+
+        REQUIRE_THROWS(ecgroup::G1FixedBase(base, 0));
+        REQUIRE_THROWS(ecgroup::G1FixedBase(base, 9));
+    }
+
     SECTION("G2Point operations") {
         ecgroup::G2Point g = ecgroup::G2Point::get_generator();
         ecgroup::G2Point g_copy = ecgroup::G2Point::get_generator();
@@ -116,6 +171,156 @@ TEST_CASE("Elliptic Curve Group Operations", "[ecgroup]") {
         REQUIRE_FALSE(e1 == e_trivial);
     }
 
+    SECTION("Multi-pairing") {
+        // A shared final exponentiation must give the same product as separate pairings
+        ecgroup::G1Point p1 = ecgroup::G1Point::get_random();
+        ecgroup::G1Point p2 = ecgroup::G1Point::get_random();
+        ecgroup::G2Point q1 = ecgroup::G2Point::get_random();
+        ecgroup::G2Point q2 = ecgroup::G2Point::get_random();
+
+        ecgroup::PairingResult expected = ecgroup::pairing(p1, q1) * ecgroup::pairing(p2, q2);
+        REQUIRE(ecgroup::multi_pairing({p1, p2}, {q1, q2}) == expected);
+        REQUIRE(ecgroup::multi_pairing({p1}, {q1}) == ecgroup::pairing(p1, q1));
+
+        REQUIRE_THROWS(ecgroup::multi_pairing({p1, p2}, {q1}));
+        REQUIRE(ecgroup::multi_pairing(p1, q1, p2, q2) == expected);
+    }
+
+    SECTION("Prepared G2 pairings") {
+        ecgroup::G1Point p1 = ecgroup::G1Point::get_random();
+        ecgroup::G1Point p2 = ecgroup::G1Point::get_random();
+        ecgroup::G2Point q1 = ecgroup::G2Point::get_random();
+        ecgroup::G2Point q2 = ecgroup::G2Point::get_random();
+        ecgroup::PreparedG2Point pq1(q1);
+        ecgroup::PreparedG2Point pq2(q2);
+
+        REQUIRE(pq1.get_point() == q1);
+        REQUIRE(ecgroup::pairing(p1, pq1) == ecgroup::pairing(p1, q1));
+        REQUIRE(ecgroup::multi_pairing(p1, pq1, p2, pq2) == ecgroup::pairing(p1, q1) * ecgroup::pairing(p2, q2));
+
+        // e(P, Q) * e(-P, Q) is the identity
+        REQUIRE(ecgroup::multi_pairing(p1, pq1, p1.negate(), pq1).is_one());
+        REQUIRE_FALSE(ecgroup::pairing(p1, pq1).is_one());
+    }
+
+    SECTION("GT fixed-base tables") {
+        ecgroup::PairingResult base = ecgroup::pairing(ecgroup::G1Point::get_random(), ecgroup::G2Point::get_random());
+        ecgroup::Scalar s = ecgroup::Scalar::get_random();
+        ecgroup::Scalar zero = s + s.negate();
+
+        for (size_t w : {1, 4, 6}) {
+            ecgroup::GTFixedBase table(base, w);
+            REQUIRE(table.pow(s) == base.pow(s));
+            REQUIRE(table.pow(s.negate()) == base.pow(s.negate()));
+            REQUIRE(table.pow(zero).is_one());
+        }
+
+        // Wiping clears the secret base and every entry but keeps the table's shape
+        ecgroup::GTFixedBase table(base, 4);
+        const size_t bytes = table.table_size_bytes();
+        table.wipe();
+        REQUIRE(table.table_size_bytes() == bytes);
+        REQUIRE_FALSE(table.get_base() == base);
+        REQUIRE_FALSE(table.pow(s) == base.pow(s));
+    }
+
+    SECTION("Deserialization validation") {
+        using ecgroup::PointEncoding;
+        using ecgroup::Validation;
+
+        uint8_t junk[ecgroup::G2_UNCOMPRESSED_SIZE];
+        std::fill(junk, junk + sizeof(junk), 0xff);
+        REQUIRE_THROWS_AS(ecgroup::Scalar::read_from(junk, ecgroup::FR_SERIALIZED_SIZE), std::invalid_argument);
+        REQUIRE_THROWS_AS(ecgroup::G1Point::read_from(junk, ecgroup::G1_SERIALIZED_SIZE), std::invalid_argument);
+        REQUIRE_THROWS_AS(ecgroup::G2Point::read_from(junk, ecgroup::G2_SERIALIZED_SIZE), std::invalid_argument);
+
+        ecgroup::G1Point p1 = ecgroup::G1Point::get_random();
+        ecgroup::G2Point p2 = ecgroup::G2Point::get_random();
+        for (Validation v : {Validation::Full, Validation::OnCurve, Validation::Trusted}) {
+            REQUIRE(ecgroup::G1Point::from_bytes(p1.to_bytes(), v) == p1);
+            REQUIRE(ecgroup::G2Point::from_bytes(p2.to_bytes(), v) == p2);
+        }
+
+        // Nudging y moves an affine point off the curve; only Trusted lets it through
+        uint8_t raw[ecgroup::G1_UNCOMPRESSED_SIZE];
+        p1.write_to(raw, PointEncoding::Uncompressed);
+        raw[ecgroup::G1_SERIALIZED_SIZE] ^= 1;
+        REQUIRE_THROWS_AS(ecgroup::G1Point::read_from(raw, sizeof(raw), PointEncoding::Uncompressed, Validation::Full),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(ecgroup::G1Point::read_from(raw, sizeof(raw), PointEncoding::Uncompressed, Validation::OnCurve),
+                          std::invalid_argument);
+        REQUIRE_NOTHROW(ecgroup::G1Point::read_from(raw, sizeof(raw), PointEncoding::Uncompressed, Validation::Trusted));
+
+        // A twist point solved straight from the curve equation, without clearing the
+        // cofactor, lies outside the prime-order subgroup of G2
+        mcl::bn::Fp2 x(mcl::bn::Fp(1), mcl::bn::Fp(0)), y, yy;
+        for (int i = 2;; ++i) {
+            mcl::bn::G2::getWeierstrass(yy, x);
+            if (mcl::bn::Fp2::squareRoot(y, yy)) {
+                break;
+            }
+            x = mcl::bn::Fp2(mcl::bn::Fp(i), mcl::bn::Fp(0));
+        }
+        uint8_t twist[ecgroup::G2_UNCOMPRESSED_SIZE];
+        x.serialize(twist, ecgroup::G2_SERIALIZED_SIZE);
+        y.serialize(twist + ecgroup::G2_SERIALIZED_SIZE, ecgroup::G2_SERIALIZED_SIZE);
+        REQUIRE_THROWS_AS(ecgroup::G2Point::read_from(twist, sizeof(twist), PointEncoding::Uncompressed, Validation::Full),
+                          std::invalid_argument);
+        REQUIRE_NOTHROW(ecgroup::G2Point::read_from(twist, sizeof(twist), PointEncoding::Uncompressed, Validation::OnCurve));
+        REQUIRE_THROWS_AS(ecgroup::G2Point::from_string("1 " + x.getStr(16) + " " + y.getStr(16)), std::invalid_argument);
+
+        // The same construction on G1 stays in the subgroup only on a cofactor-1 curve
+        mcl::bn::Fp gx(1), gy, gyy;
+        for (int i = 2;; ++i) {
+            mcl::bn::G1::getWeierstrass(gyy, gx);
+            if (mcl::bn::Fp::squareRoot(gy, gyy)) {
+                break;
+            }
+            gx = mcl::bn::Fp(i);
+        }
+        uint8_t affine[ecgroup::G1_UNCOMPRESSED_SIZE];
+        gx.serialize(affine, ecgroup::G1_SERIALIZED_SIZE);
+        gy.serialize(affine + ecgroup::G1_SERIALIZED_SIZE, ecgroup::G1_SERIALIZED_SIZE);
+        REQUIRE_NOTHROW(ecgroup::G1Point::read_from(affine, sizeof(affine), PointEncoding::Uncompressed, Validation::OnCurve));
+        if (ecgroup::Curve::G1_PRIME_ORDER) {
+            REQUIRE_NOTHROW(ecgroup::G1Point::read_from(affine, sizeof(affine), PointEncoding::Uncompressed, Validation::Full));
+        } else {
+            REQUIRE_THROWS_AS(ecgroup::G1Point::read_from(affine, sizeof(affine), PointEncoding::Uncompressed, Validation::Full),
+                              std::invalid_argument);
+        }
+    }
+
+    SECTION("Streaming transcript") {
+        ecgroup::Bytes message(100000, 0x5a);
+        ecgroup::G1Point p = ecgroup::G1Point::get_random();
+        ecgroup::PairingResult gt = ecgroup::pairing(p, ecgroup::G2Point::get_random());
+
+        ecgroup::Transcript transcript;
+        transcript.absorb(message);
+        transcript.absorb(p);
+        transcript.absorb(gt);
+
+        ecgroup::Bytes concatenated = message;
+        for (const ecgroup::Bytes& b : {p.to_bytes(), gt.to_bytes()}) {
+            concatenated.insert(concatenated.end(), b.begin(), b.end());
+        }
+        REQUIRE(transcript.challenge() == ecgroup::Scalar::hash_to_scalar(concatenated));
+
+        // Compressed GT absorbs agree for equal elements and differ for distinct ones
+        ecgroup::PairingResult gt2 = gt * gt;
+        uint8_t c1[ecgroup::GT_COMPRESSED_SIZE], c2[ecgroup::GT_COMPRESSED_SIZE];
+        gt.write_compressed_to(c1);
+        ecgroup::PairingResult::from_bytes(gt.to_bytes()).write_compressed_to(c2);
+        REQUIRE(ecgroup::Bytes(c1, c1 + sizeof(c1)) == ecgroup::Bytes(c2, c2 + sizeof(c2)));
+        gt2.write_compressed_to(c2);
+        REQUIRE(ecgroup::Bytes(c1, c1 + sizeof(c1)) != ecgroup::Bytes(c2, c2 + sizeof(c2)));
+        (gt / gt).write_compressed_to(c2);
+        REQUIRE(c2[0] == 1);
+
+        ecgroup::Transcript empty;
+        REQUIRE(empty.challenge() == ecgroup::Scalar::hash_to_scalar(ecgroup::Bytes()));
+    }
+
     SECTION("Serialization") {
         // Test round-trip serialization for Scalar
         ecgroup::Scalar s1;
@@ -145,5 +350,34 @@ TEST_CASE("Elliptic Curve Group Operations", "[ecgroup]") {
         ecgroup::G2Point p2_from_bytes = ecgroup::G2Point::from_bytes(p2_bytes);
         REQUIRE(p2 == p2_from_str);
         REQUIRE(p2 == p2_from_bytes);
+
+        // Buffer-based paths produce the same encoding as the vector APIs
+        uint8_t buf[ecgroup::GT_SERIALIZED_SIZE];
+        s1.write_to(buf);
+        REQUIRE(ecgroup::Bytes(buf, buf + ecgroup::FR_SERIALIZED_SIZE) == s1_bytes);
+        REQUIRE(ecgroup::Scalar::read_from(buf, ecgroup::FR_SERIALIZED_SIZE) == s1);
+        p1.write_to(buf);
+        REQUIRE(ecgroup::Bytes(buf, buf + ecgroup::G1_SERIALIZED_SIZE) == p1_bytes);
+        REQUIRE(ecgroup::G1Point::read_from(buf, ecgroup::G1_SERIALIZED_SIZE) == p1);
+        p2.write_to(buf);
+        REQUIRE(ecgroup::Bytes(buf, buf + ecgroup::G2_SERIALIZED_SIZE) == p2_bytes);
+        REQUIRE(ecgroup::G2Point::read_from(buf, ecgroup::G2_SERIALIZED_SIZE) == p2);
+
+        // Uncompressed affine encodings round-trip, including the identity
+        p1.write_to(buf, ecgroup::PointEncoding::Uncompressed);
+        REQUIRE(ecgroup::G1Point::read_from(buf, ecgroup::G1_UNCOMPRESSED_SIZE, ecgroup::PointEncoding::Uncompressed) == p1);
+        p2.write_to(buf, ecgroup::PointEncoding::Uncompressed);
+        REQUIRE(ecgroup::G2Point::read_from(buf, ecgroup::G2_UNCOMPRESSED_SIZE, ecgroup::PointEncoding::Uncompressed) == p2);
+        ecgroup::G1Point identity = p1.add(p1.negate());
+        identity.write_to(buf, ecgroup::PointEncoding::Uncompressed);
+        REQUIRE(ecgroup::G1Point::read_from(buf, ecgroup::G1_UNCOMPRESSED_SIZE, ecgroup::PointEncoding::Uncompressed) == identity);
+        REQUIRE_THROWS_AS(ecgroup::G1Point::read_from(buf, ecgroup::G1_UNCOMPRESSED_SIZE - 1, ecgroup::PointEncoding::Uncompressed),
+                          std::out_of_range);
+
+        ecgroup::PairingResult gt = ecgroup::pairing(p1, p2);
+        gt.write_to(buf);
+        REQUIRE(ecgroup::Bytes(buf, buf + ecgroup::GT_SERIALIZED_SIZE) == gt.to_bytes());
+        REQUIRE(ecgroup::PairingResult::read_from(buf, ecgroup::GT_SERIALIZED_SIZE) == gt);
+        REQUIRE(ecgroup::PairingResult::from_bytes(gt.to_bytes()) == gt);
     }
 }
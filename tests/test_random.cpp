@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+#include "random.hpp"
+#include "ecgroup.hpp"
+
+namespace {
+    // Forwards to a seeded generator and counts how often it was asked for bytes.
+    class CountingSource : public ecgroup::RandomSource {
+    public:
+        explicit CountingSource(const uint8_t (&seed)[ecgroup::ChaCha20Rng::KEY_SIZE]) : rng(seed) {}
+
+        void fill(uint8_t* out, size_t len) override {
+            ++calls;
+            rng.fill(out, len);
+        }
+
+        size_t calls = 0;
+
+    private:
+        ecgroup::ChaCha20Rng rng;
+    };
+}
+
+TEST_CASE("Random Scalar Generation", "[random]") {
+    ecgroup::init_pairing();
+
+    SECTION("ChaCha20 block function matches RFC 8439") {
+        // RFC 8439, section 2.3.2
+        uint32_t key[8];
+        for (uint32_t i = 0; i < 8; ++i) {
+            key[i] = (4 * i) | (4 * i + 1) << 8 | (4 * i + 2) << 16 | (4 * i + 3) << 24;
+        }
+        const uint32_t nonce[3] = {0x09000000, 0x4a000000, 0x00000000};
+        const uint8_t expected[64] = {
+            0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+            0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+            0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+            0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e,
+        };
+        uint8_t out[64];
+        ecgroup::chacha20_block(key, 1, nonce, out);
+        REQUIRE(std::vector<uint8_t>(out, out + 64) == std::vector<uint8_t>(expected, expected + 64));
+    }
+
+    SECTION("Seeded mode is reproducible") {
+        ecgroup::set_random_seed(7);
+        std::vector<ecgroup::Scalar> first(5);
+        ecgroup::Scalar::fill_random(first.data(), first.size());
+
+        ecgroup::set_random_seed(7);
+        std::vector<ecgroup::Scalar> second(5);
+        ecgroup::Scalar::fill_random(second.data(), second.size());
+        REQUIRE(first == second);
+
+        ecgroup::clear_random_seed();
+        REQUIRE_FALSE(ecgroup::Scalar::get_random() == first[0]);
+    }
+
+    SECTION("Threads get distinct streams under one seed") {
+        ecgroup::set_random_seed(11);
+        ecgroup::Scalar main_draw = ecgroup::Scalar::get_random();
+        ecgroup::Scalar thread_draw;
+        std::thread([&] { thread_draw = ecgroup::Scalar::get_random(); }).join();
+        ecgroup::clear_random_seed();
+        REQUIRE_FALSE(main_draw == thread_draw);
+    }
+
+    SECTION("Bulk fill yields distinct scalars") {
+        std::vector<ecgroup::Scalar> scalars(50);
+        ecgroup::Scalar::fill_random(scalars.data(), scalars.size());
+        for (size_t i = 0; i < scalars.size(); ++i) {
+            for (size_t j = i + 1; j < scalars.size(); ++j) {
+                REQUIRE_FALSE(scalars[i] == scalars[j]);
+            }
+        }
+    }
+
+    SECTION("Installed source replaces the thread generators") {
+        const uint8_t seed[ecgroup::ChaCha20Rng::KEY_SIZE] = {1, 2, 3};
+        CountingSource source(seed);
+        ecgroup::set_random_source(&source);
+        ecgroup::Scalar a = ecgroup::Scalar::get_random();
+        ecgroup::set_random_source(nullptr);
+        REQUIRE(source.calls > 0);
+
+        CountingSource replay(seed);
+        ecgroup::set_random_source(&replay);
+        ecgroup::Scalar b = ecgroup::Scalar::get_random();
+        ecgroup::set_random_source(nullptr);
+        REQUIRE(a == b);
+    }
+}
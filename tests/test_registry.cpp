@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "bbsgs/bbsgs.hpp"
+
+TEST_CASE("Member Registry", "[registry]") {
+    ecgroup::init_pairing();
+
+    bbsgs::GroupPublicKey gpk;
+    bbsgs::OpenerSecretKey osk;
+    bbsgs::IssuerSecretKey isk;
+    bbsgs::bbs04_setup(gpk, osk, isk);
+
+    std::vector<bbsgs::UserSecretKey> members;
+    for (int i = 0; i < 8; ++i) {
+        members.push_back(bbsgs::bbs04_user_keygen(isk, gpk));
+    }
+    ecgroup::Bytes message = {'r', 'e', 'g'};
+
+    SECTION("Open then lookup") {
+        bbsgs::MemberRegistry registry(members.size());
+        for (size_t i = 0; i < members.size(); ++i) {
+            REQUIRE(registry.add(members[i].A, 1000 + i));
+        }
+        REQUIRE(registry.size() == members.size());
+
+        // Duplicate credentials are rejected and the table refuses to overfill
+        REQUIRE_FALSE(registry.add(members[0].A, 42));
+        REQUIRE_THROWS_AS(registry.add(ecgroup::G1Point::get_random(), 42), std::length_error);
+
+        bbsgs::GroupSignature sigma = bbsgs::bbs04_sign(gpk, members[5], message);
+        uint64_t member_id = 0;
+        REQUIRE(registry.find(bbsgs::bbs04_open(gpk, osk, sigma), member_id));
+        REQUIRE(member_id == 1005);
+
+        REQUIRE_FALSE(registry.find(ecgroup::G1Point::get_random(), member_id));
+    }
+
+    SECTION("Concurrent lookups during appends") {
+        bbsgs::MemberRegistry registry(members.size());
+        REQUIRE(registry.add(members[0].A, 0));
+
+        // Catch2 assertions are not thread-safe, so the reader only records failures
+        std::atomic<int> reader_failures(0);
+        std::thread reader([&]() {
+            uint64_t id = 0;
+            for (int i = 0; i < 1000; ++i) {
+                if (!registry.find(members[0].A, id) || id != 0) {
+                    reader_failures.fetch_add(1);
+                }
+            }
+        });
+        for (size_t i = 1; i < members.size(); ++i) {
+            REQUIRE(registry.add(members[i].A, i));
+        }
+        reader.join();
+        REQUIRE(reader_failures.load() == 0);
+        REQUIRE(registry.size() == members.size());
+    }
+
+    SECTION("Appends become visible to running readers") {
+        bbsgs::MemberRegistry registry(members.size());
+
+        // The writer waits for the reader to see each member before adding the next,
+        // so every lookup below races a live writer rather than running after join()
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        std::atomic<size_t> seen(0);
+        std::atomic<int> reader_failures(0);
+        std::thread reader([&]() {
+            uint64_t id = 0;
+            for (size_t i = 0; i < members.size(); ++i) {
+                while (!registry.find(members[i].A, id)) {
+                    if (std::chrono::steady_clock::now() > deadline) {
+                        reader_failures.fetch_add(1);
+                        return;
+                    }
+                    std::this_thread::yield();
+                }
+                if (id != 100 + i) {
+                    reader_failures.fetch_add(1);
+                }
+                seen.store(i + 1, std::memory_order_release);
+            }
+        });
+
+        size_t added = 0;
+        for (size_t i = 0; i < members.size(); ++i) {
+            added += registry.add(members[i].A, 100 + i) ? 1 : 0;
+            while (seen.load(std::memory_order_acquire) <= i && std::chrono::steady_clock::now() <= deadline) {
+                std::this_thread::yield();
+            }
+        }
+        reader.join();
+        REQUIRE(added == members.size());
+        REQUIRE(reader_failures.load() == 0);
+        REQUIRE(seen.load() == members.size());
+    }
+
+    SECTION("Persistence") {
+        std::string path = (std::filesystem::temp_directory_path() / "bbsgs_registry_test.bin").string();
+        std::remove(path.c_str());
+
+        {
+            bbsgs::MemberRegistry registry(path, 100);
+            for (size_t i = 0; i < members.size(); ++i) {
+                REQUIRE(registry.add(members[i].A, i));
+            }
+            registry.flush();
+        }
+
+        // Reopening keeps the stored capacity and contents
+        {
+            bbsgs::MemberRegistry reopened(path, 1);
+            REQUIRE(reopened.capacity() == 100);
+            REQUIRE(reopened.size() == members.size());
+            uint64_t member_id = 0;
+            REQUIRE(reopened.find(members[3].A, member_id));
+            REQUIRE(member_id == 3);
+        }
+
+        // A file cut short of its slot array, or even of its header, is refused
+        // instead of being mapped and faulting on first access
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+        REQUIRE_THROWS_AS(bbsgs::MemberRegistry(path, 1), std::runtime_error);
+        std::filesystem::resize_file(path, 16);
+        REQUIRE_THROWS_AS(bbsgs::MemberRegistry(path, 1), std::runtime_error);
+
+        std::remove(path.c_str());
+    }
+}